@@ -144,6 +144,66 @@ namespace internal
         return {a0, a2, a4, a6};
     }
 
+    Ellipsoid_Kruger_Series_Coefficient
+    calcEllipsoid_Kruger_Series_Coefficient(
+        const Ellipsoid_Geometry_Property &p_geometry)
+    {
+        // Karney, Transverse Mercator with an accuracy of a few nanometers, J. Geodesy 85 (2011), eq. (14), (35), (36)
+        double
+            f = p_geometry.alpha,
+            n = f / (2.0 - f),
+            n2 = n * n,
+            n3 = n2 * n,
+            n4 = n3 * n,
+            n5 = n4 * n,
+            n6 = n5 * n;
+        return {
+            .n = n,
+            .e = std::sqrt(p_geometry.e1_2),
+            .A = p_geometry.a / (1.0 + n) * (1.0 + n2 / 4.0 + n4 / 64.0 + n6 / 256.0),
+            .alpha{
+                n / 2.0 - n2 * 2.0 / 3.0 + n3 * 5.0 / 16.0 + n4 * 41.0 / 180.0 - n5 * 127.0 / 288.0 +
+                    n6 * 7891.0 / 37800.0,
+                n2 * 13.0 / 48.0 - n3 * 3.0 / 5.0 + n4 * 557.0 / 1440.0 + n5 * 281.0 / 630.0 -
+                    n6 * 1983433.0 / 1935360.0,
+                n3 * 61.0 / 240.0 - n4 * 103.0 / 140.0 + n5 * 15061.0 / 26880.0 + n6 * 167603.0 / 181440.0,
+                n4 * 49561.0 / 161280.0 - n5 * 179.0 / 168.0 + n6 * 6601661.0 / 7257600.0,
+                n5 * 34729.0 / 80640.0 - n6 * 3418889.0 / 1995840.0,
+                n6 * 212378941.0 / 319334400.0},
+            .beta{
+                n / 2.0 - n2 * 2.0 / 3.0 + n3 * 37.0 / 96.0 - n4 / 360.0 - n5 * 81.0 / 512.0 +
+                    n6 * 96199.0 / 604800.0,
+                n2 / 48.0 + n3 / 15.0 - n4 * 437.0 / 1440.0 + n5 * 46.0 / 105.0 - n6 * 1118711.0 / 3870720.0,
+                n3 * 17.0 / 480.0 - n4 * 37.0 / 840.0 - n5 * 209.0 / 4480.0 + n6 * 5569.0 / 90720.0,
+                n4 * 4397.0 / 161280.0 - n5 * 11.0 / 504.0 - n6 * 830251.0 / 7257600.0,
+                n5 * 4583.0 / 161280.0 - n6 * 108847.0 / 3991680.0,
+                n6 * 20648693.0 / 638668800.0}};
+    }
+
+    Ellipsoid_Footpoint_Latitude_Coefficient
+    calcEllipsoid_Footpoint_Latitude_Coefficient(
+        const Ellipsoid_Geometry_Property &p_geometry)
+    {
+        // inverse of rectifying latitude series, same expansion as `calcEllipsoid_Kruger_Series_Coefficient`
+        double
+            f = p_geometry.alpha,
+            n = f / (2.0 - f),
+            n2 = n * n,
+            n3 = n2 * n,
+            n4 = n3 * n,
+            n5 = n4 * n,
+            n6 = n5 * n;
+        return {
+            .A = p_geometry.a / (1.0 + n) * (1.0 + n2 / 4.0 + n4 / 64.0 + n6 / 256.0),
+            .delta{
+                n * 3.0 / 2.0 - n3 * 27.0 / 32.0 + n5 * 269.0 / 512.0,
+                n2 * 21.0 / 16.0 - n4 * 55.0 / 32.0 + n6 * 6759.0 / 4096.0,
+                n3 * 151.0 / 96.0 - n5 * 417.0 / 128.0,
+                n4 * 1097.0 / 512.0 - n6 * 15543.0 / 2560.0,
+                n5 * 8011.0 / 2560.0,
+                n6 * 293393.0 / 61440.0}};
+    }
+
     Ellipsoid
     calcEllipsoid_Property(
         const Ellipsoid_Geometry_Property &p_geo)
@@ -157,7 +217,9 @@ namespace internal
         return Ellipsoid{
             .geometry{p_geo},
             .principle_curvature_radius_coeff{prc_coeff},
-            .quarter_arc_coeff{qa_coeff}};
+            .quarter_arc_coeff{qa_coeff},
+            .kruger_series_coeff{calcEllipsoid_Kruger_Series_Coefficient(p_geo)},
+            .footpoint_coeff{calcEllipsoid_Footpoint_Latitude_Coefficient(p_geo)}};
     }
 
     Ellipsoid
@@ -333,29 +395,31 @@ double meridianArcLength(const Latitude &p_lat, const Ellipsoid &p_ellipsoid)
     return X;
 }
 
-Latitude meridianArcBottom(double p_len, const Ellipsoid &p_ellipsoid)
+namespace internal
 {
-    const auto &
-        coeff{p_ellipsoid.quarter_arc_coeff};
-
-    double Bf_cur = deg2rad(p_len / coeff.a0), Bf_next = Bf_cur, FB = 0; // rad
-    double dB = (p_ellipsoid.quarter_arc_length_adjust_fn)(p_len);
-
-    if (eqApprox(Bf_cur, 0.0))
+    double meridianArcBottomRad(double p_len, const Ellipsoid &p_ellipsoid)
     {
-        return Latitude(Bf_cur);
+        const Ellipsoid_Footpoint_Latitude_Coefficient &coeff{p_ellipsoid.footpoint_coeff};
+        const double
+            mu = p_len / coeff.A,
+            sin_2mu = std::sin(2.0 * mu),
+            cos_2mu = std::cos(2.0 * mu);
+
+        // Clenshaw summation of `sum(delta[j - 1] * sin(2 * j * mu))`
+        double b1 = 0.0, b2 = 0.0;
+        for (size_t j = coeff.delta.size(); j != 0; --j)
+        {
+            const double b0 = 2.0 * cos_2mu * b1 - b2 + coeff.delta[j - 1];
+            b2 = b1;
+            b1 = b0;
+        }
+        return mu + b1 * sin_2mu; // return rad
     }
+}
 
-    do
-    {
-        Bf_cur = Bf_next;
-        FB =
-            -coeff.a2 * std::sin(2 * Bf_cur) +
-            coeff.a4 * std::sin(4 * Bf_cur) -
-            coeff.a6 * std::sin(6 * Bf_cur);
-        Bf_next = deg2rad((p_len - FB) / coeff.a0); // deg -> rad
-    } while (Bf_next - Bf_cur >= config::geodesy.meridian_arc_bottom.threshold);
-    return Latitude(Bf_cur + dB); // return rad
+Latitude meridianArcBottom(double p_len, const Ellipsoid &p_ellipsoid)
+{
+    return Latitude(internal::meridianArcBottomRad(p_len, p_ellipsoid));
 }
 
 M_libga_end
\ No newline at end of file
@@ -1,3 +1,10 @@
+#include <cmath>
+#include <optional>
+#include <algorithm>
+
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+
 #include <lga/Geodesy>
 
 M_libga_begin
@@ -29,6 +36,152 @@ M_libga_begin
     {
         return Longitude(deg2rad(6 * p_zone - 3));
     }
+
+    int gaussZone(double p_lon, double p_interval) noexcept
+    {
+        const double interval = deg2rad(p_interval);
+        return p_interval == 6.0
+                   ? int(p_lon / interval) + 1
+                   : int(p_lon / interval) + (std::fmod(p_lon, interval) > interval / 2.0 ? 1 : 0);
+    }
+
+    void validateGaussInterval(double p_interval)
+    {
+        if (p_interval != 3.0 && p_interval != 6.0)
+        {
+            throw std::invalid_argument(std::format(
+                "unknown gauss interval {:f}", p_interval));
+        }
+    }
+
+    void validateGaussBatchSize(size_t p_expect, std::initializer_list<size_t> p_sizes)
+    {
+        for (size_t size : p_sizes)
+        {
+            if (size != p_expect)
+            {
+                throw std::invalid_argument(std::format(
+                    "batch gauss projection got array of {:d} points, expect {:d}", size, p_expect));
+            }
+        }
+    }
+
+    void validateGaussBatchLatLon(std::span<const double> p_lat, std::span<const double> p_lon)
+    {
+        for (size_t i = 0; i != p_lat.size(); ++i)
+        {
+            // same checks as `Latitude` and `Longitude`, done once before the parallel part
+            Latitude{p_lat[i]};
+            Longitude{p_lon[i]};
+        }
+    }
+
+    void validateGaussContext(const Gauss_Project_Coordinate &p_gpc, const Gauss_Projection_Context &p_context)
+    {
+        if (p_gpc.zone != p_context.zone() || p_gpc.interval != p_context.interval())
+        {
+            throw std::invalid_argument(std::format(
+                "coordinate of zone {:d} ({:f}) given to context of zone {:d} ({:f})",
+                p_gpc.zone, p_gpc.interval, p_context.zone(), p_context.interval()));
+        }
+    }
+}
+
+Gauss_Projection_Context::Gauss_Projection_Context(const Ellipsoid &p_ellipsoid, double p_interval, int p_zone)
+    : m_ellipsoid(&p_ellipsoid),
+      m_interval(p_interval),
+      m_zone(p_zone),
+      m_center(Gauss_Projector{}.centerMeridian(p_zone, p_interval)),
+      m_a(p_ellipsoid.geometry.a),
+      m_e1_2(p_ellipsoid.geometry.e1_2),
+      m_e2_2(p_ellipsoid.geometry.e2_2),
+      // `a0` is per degree
+      m_arc_a0(p_ellipsoid.quarter_arc_coeff.a0 * rad2deg(1.0)),
+      m_arc_a2(p_ellipsoid.quarter_arc_coeff.a2),
+      m_arc_a4(p_ellipsoid.quarter_arc_coeff.a4),
+      m_arc_a6(p_ellipsoid.quarter_arc_coeff.a6)
+{
+}
+
+const Ellipsoid &Gauss_Projection_Context::ellipsoid() const noexcept
+{
+    return *m_ellipsoid;
+}
+
+double Gauss_Projection_Context::interval() const noexcept
+{
+    return m_interval;
+}
+
+int Gauss_Projection_Context::zone() const noexcept
+{
+    return m_zone;
+}
+
+const Longitude &Gauss_Projection_Context::centerMeridian() const noexcept
+{
+    return m_center;
+}
+
+void Gauss_Projection_Context::forward(double p_lat, double p_lon, double &p_x, double &p_y) const noexcept
+{
+    const double
+        l = p_lon - m_center.rad(),
+        sinB = std::sin(p_lat),
+        cosB = std::cos(p_lat),
+        // meridian arc from multiple angles of a single sin/cos pair
+        sin2B = 2.0 * sinB * cosB,
+        cos2B = 1.0 - 2.0 * sinB * sinB,
+        sin4B = 2.0 * sin2B * cos2B,
+        cos4B = 1.0 - 2.0 * sin2B * sin2B,
+        sin6B = sin4B * cos2B + cos4B * sin2B,
+        X = m_arc_a0 * p_lat - m_arc_a2 * sin2B + m_arc_a4 * sin4B - m_arc_a6 * sin6B,
+        N = m_a / std::sqrt(1.0 - m_e1_2 * sinB * sinB),
+        t = sinB / cosB,
+        t2 = t * t,
+        t4 = t2 * t2,
+        n2 = m_e2_2 * cosB * cosB,
+        m = cosB * l,
+        m2 = m * m;
+
+    p_x = X +
+          N * t * m2 *
+              (1.0 / 2.0 +
+               m2 * ((5.0 - t2 + 9.0 * n2 + 4.0 * n2 * n2) / 24.0 +
+                     m2 * (61.0 - 58.0 * t2 + t4) / 720.0));
+    p_y = N * m *
+          (1.0 +
+           m2 * ((1.0 - t2 + n2) / 6.0 +
+                 m2 * (5.0 - 18.0 * t2 + t4 + 14.0 * n2 - 58.0 * n2 * t2) / 120.0));
+}
+
+void Gauss_Projection_Context::inverse(double p_x, double p_y, double &p_lat, double &p_lon) const
+{
+    const double
+        Bf = internal::meridianArcBottomRad(p_x, *m_ellipsoid),
+        sinBf = std::sin(Bf),
+        cosBf = std::cos(Bf),
+        w2 = 1.0 - m_e1_2 * sinBf * sinBf,
+        Nf = m_a / std::sqrt(w2),
+        // Nf / Mf
+        v2 = w2 / (1.0 - m_e1_2),
+        tf = sinBf / cosBf,
+        tf2 = tf * tf,
+        tf4 = tf2 * tf2,
+        nf2 = m_e2_2 * cosBf * cosBf,
+        q = p_y / Nf,
+        q2 = q * q;
+
+    p_lat = Bf -
+            tf * v2 * q2 *
+                (1.0 / 2.0 -
+                 q2 * ((5.0 + 3.0 * tf2 + nf2 - 9.0 * nf2 * tf2) / 24.0 -
+                       q2 * (61.0 + 90.0 * tf2 + 45.0 * tf4) / 720.0));
+    p_lon = m_center.rad() +
+            q / cosBf *
+                (1.0 -
+                 q2 * ((1.0 + 2.0 * tf2 + nf2) / 6.0 -
+                       q2 * (5.0 + 28.0 * tf2 + 24.0 * tf4 + 6.0 * nf2 + 8.0 * nf2 * tf2) / 120.0));
 }
 
 int Gauss_Projector::
@@ -194,6 +347,142 @@ Gauss_Projector::
         .lon = Longitude(Lc.rad() + dl)};
 }
 
+void Gauss_Projector::
+    forward(
+        std::span<const double> p_lat,
+        std::span<const double> p_lon,
+        double p_interval,
+        const Ellipsoid &p_ellipsoid,
+        std::span<double> p_x,
+        std::span<double> p_y,
+        std::span<int> p_zones,
+        int p_zone) const
+{
+    const size_t n = p_lat.size();
+    internal::validateGaussInterval(p_interval);
+    internal::validateGaussBatchSize(n, {p_lon.size(), p_x.size(), p_y.size(), p_zones.size()});
+    internal::validateGaussBatchLatLon(p_lat, p_lon);
+
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, n, internal::gauss_project_chunk),
+        [&](const tbb::blocked_range<size_t> &p_range)
+        {
+            // points of a chunk mostly share one zone
+            std::optional<Gauss_Projection_Context> context;
+            for (size_t i = p_range.begin(); i != p_range.end(); ++i)
+            {
+                const double L = p_lon[i];
+                const int zone = p_zone != -1 ? p_zone : internal::gaussZone(L, p_interval);
+                if (!context || context->zone() != zone)
+                {
+                    context.emplace(p_ellipsoid, p_interval, zone);
+                }
+                context->forward(p_lat[i], L, p_x[i], p_y[i]);
+                p_zones[i] = zone;
+            }
+        });
+}
+
+void Gauss_Projector::
+    inverse(
+        std::span<const double> p_x,
+        std::span<const double> p_y,
+        std::span<const int> p_zones,
+        double p_interval,
+        const Ellipsoid &p_ellipsoid,
+        std::span<double> p_lat,
+        std::span<double> p_lon) const
+{
+    const size_t n = p_x.size();
+    internal::validateGaussInterval(p_interval);
+    internal::validateGaussBatchSize(n, {p_y.size(), p_zones.size(), p_lat.size(), p_lon.size()});
+
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, n, internal::gauss_project_chunk),
+        [&](const tbb::blocked_range<size_t> &p_range)
+        {
+            std::optional<Gauss_Projection_Context> context;
+            for (size_t i = p_range.begin(); i != p_range.end(); ++i)
+            {
+                if (!context || context->zone() != p_zones[i])
+                {
+                    context.emplace(p_ellipsoid, p_interval, p_zones[i]);
+                }
+                context->inverse(p_x[i], p_y[i], p_lat[i], p_lon[i]);
+            }
+        });
+}
+
+Gauss_Project_Coordinate
+Gauss_Projector::
+    forward(
+        const Geodetic_Coordinate &p_gc,
+        const Gauss_Projection_Context &p_context) const
+{
+    Gauss_Project_Coordinate gpc{.interval = p_context.interval(), .x = 0.0, .y = 0.0, .zone = p_context.zone()};
+    p_context.forward(p_gc.lat.rad(), p_gc.lon.rad(), gpc.x, gpc.y);
+    return gpc;
+}
+
+Geodetic_Coordinate
+Gauss_Projector::
+    inverse(
+        const Gauss_Project_Coordinate &p_gpc,
+        const Gauss_Projection_Context &p_context) const
+{
+    internal::validateGaussContext(p_gpc, p_context);
+    double lat = 0.0, lon = 0.0;
+    p_context.inverse(p_gpc.x, p_gpc.y, lat, lon);
+    return Geodetic_Coordinate{
+        .lat = Latitude(lat),
+        .lon = Longitude(lon)};
+}
+
+void Gauss_Projector::
+    forward(
+        std::span<const double> p_lat,
+        std::span<const double> p_lon,
+        const Gauss_Projection_Context &p_context,
+        std::span<double> p_x,
+        std::span<double> p_y) const
+{
+    const size_t n = p_lat.size();
+    internal::validateGaussBatchSize(n, {p_lon.size(), p_x.size(), p_y.size()});
+    internal::validateGaussBatchLatLon(p_lat, p_lon);
+
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, n, internal::gauss_project_chunk),
+        [&](const tbb::blocked_range<size_t> &p_range)
+        {
+            for (size_t i = p_range.begin(); i != p_range.end(); ++i)
+            {
+                p_context.forward(p_lat[i], p_lon[i], p_x[i], p_y[i]);
+            }
+        });
+}
+
+void Gauss_Projector::
+    inverse(
+        std::span<const double> p_x,
+        std::span<const double> p_y,
+        const Gauss_Projection_Context &p_context,
+        std::span<double> p_lat,
+        std::span<double> p_lon) const
+{
+    const size_t n = p_x.size();
+    internal::validateGaussBatchSize(n, {p_y.size(), p_lat.size(), p_lon.size()});
+
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, n, internal::gauss_project_chunk),
+        [&](const tbb::blocked_range<size_t> &p_range)
+        {
+            for (size_t i = p_range.begin(); i != p_range.end(); ++i)
+            {
+                p_context.inverse(p_x[i], p_y[i], p_lat[i], p_lon[i]);
+            }
+        });
+}
+
 Gauss_Project_Coordinate
 Gauss_Projector::
 operator()(
@@ -288,6 +577,50 @@ Angle Gauss_Projector::
     return Angle(gamma);
 }
 
+Angle Gauss_Projector::
+    meridianConvergence(
+        const Geodetic_Coordinate &p_gc,
+        const Gauss_Projection_Context &p_context) const
+{
+    const double
+        l = p_gc.lon.rad() - p_context.centerMeridian().rad(),
+        sinB = p_gc.lat.sin(),
+        cosB = p_gc.lat.cos(),
+        t2 = std::pow(sinB / cosB, 2),
+        n2 = p_context.ellipsoid().geometry.e2_2 * cosB * cosB,
+        m2 = std::pow(cosB * l, 2);
+    double gamma =
+        sinB * l *
+        (1.0 +
+         m2 * ((1 + 3 * n2 + 2 * n2 * n2) / 3.0 +
+               m2 * (2 - t2) / 15.0));
+    return Angle(gamma);
+}
+
+Angle Gauss_Projector::
+    meridianConvergence(
+        const Gauss_Project_Coordinate &p_gpc,
+        const Gauss_Projection_Context &p_context) const
+{
+    internal::validateGaussContext(p_gpc, p_context);
+    const Ellipsoid_Geometry_Property &geo = p_context.ellipsoid().geometry;
+    const double
+        Bf = internal::meridianArcBottomRad(p_gpc.x, p_context.ellipsoid()),
+        sinBf = std::sin(Bf),
+        cosBf = std::cos(Bf),
+        t = sinBf / cosBf,
+        t2 = t * t,
+        n2 = geo.e2_2 * cosBf * cosBf,
+        q = p_gpc.y / (geo.a / std::sqrt(1.0 - geo.e1_2 * sinBf * sinBf)),
+        q2 = q * q;
+    double gamma =
+        t * q *
+        (1.0 -
+         q2 * ((1 + t2 - n2) / 3.0 -
+               q2 * (2 + 5 * t2 + 3 * t2 * t2) / 15.0));
+    return Angle(gamma);
+}
+
 Gauss_Project_Direction_Correction
 Gauss_Projector::
     directionCorrection(
@@ -326,7 +659,51 @@ Gauss_Projector::
             n2 * t / Rm3 * (y2 - y1) * ym2,
         delta_backward =
             (x2 - x1) / (6 * Rm2) * (2 * y2 + y1 - ym3 / Rm2) +
-            n2 * t / Rm3 + (y2 - y1) * ym2;
+            n2 * t / Rm3 * (y2 - y1) * ym2;
+    return Gauss_Project_Direction_Correction{
+        .forward = Angle(delta_forward),
+        .backward = Angle(delta_backward)};
+}
+
+Gauss_Project_Direction_Correction
+Gauss_Projector::
+    directionCorrection(
+        const Gauss_Project_Coordinate &p_gpc1,
+        const Gauss_Project_Coordinate &p_gpc2,
+        const Gauss_Projection_Context &p_context) const
+{
+    internal::validateGaussContext(p_gpc1, p_context);
+    internal::validateGaussContext(p_gpc2, p_context);
+    const Ellipsoid_Geometry_Property &geo = p_context.ellipsoid().geometry;
+    double B1 = 0.0, B2 = 0.0, l = 0.0;
+    p_context.inverse(p_gpc1.x, p_gpc1.y, B1, l);
+    p_context.inverse(p_gpc2.x, p_gpc2.y, B2, l);
+
+    const double
+        x1 = p_gpc1.x,
+        y1 = p_gpc1.y,
+        x2 = p_gpc2.x,
+        y2 = p_gpc2.y,
+        ym = (y1 + y2) / 2.0,
+        ym2 = ym * ym,
+        ym3 = ym2 * ym,
+        Bm = (B1 + B2) / 2.0,
+        sinBm = std::sin(Bm),
+        cosBm = std::cos(Bm),
+        k = 1.0 - geo.e1_2 * sinBm * sinBm,
+        // mean curvature radius, sqrt(M * N)
+        Rm2 = geo.a * geo.a * (1.0 - geo.e1_2) / (k * k),
+        Rm3 = Rm2 * std::sqrt(Rm2),
+        n2 = geo.e2_2 * cosBm * cosBm,
+        t = sinBm / cosBm;
+
+    double
+        delta_forward =
+            -(x2 - x1) / (6 * Rm2) * (2 * y1 + y2 - ym3 / Rm2) -
+            n2 * t / Rm3 * (y2 - y1) * ym2,
+        delta_backward =
+            (x2 - x1) / (6 * Rm2) * (2 * y2 + y1 - ym3 / Rm2) +
+            n2 * t / Rm3 * (y2 - y1) * ym2;
     return Gauss_Project_Direction_Correction{
         .forward = Angle(delta_forward),
         .backward = Angle(delta_backward)};
@@ -414,6 +791,43 @@ Gauss_Projector::
     return m;
 }
 
+double
+Gauss_Projector::
+    stretch(
+        const Geodetic_Coordinate &p_gc,
+        const Gauss_Projection_Context &p_context) const noexcept
+{
+    const double
+        l = p_context.centerMeridian().rad() - p_gc.lon.rad(),
+        cosB = p_gc.lat.cos(),
+        t2 = std::pow(p_gc.lat.tan(), 2),
+        n2 = p_context.ellipsoid().geometry.e2_2 * cosB * cosB,
+        m2 = std::pow(cosB * l, 2);
+    return 1.0 +
+           m2 * ((1 + n2) / 2.0 +
+                 m2 * (5 - 4 * t2) / 24.0);
+}
+
+double
+Gauss_Projector::
+    stretch(
+        const Gauss_Project_Coordinate &p_gpc,
+        const Gauss_Projection_Context &p_context) const
+{
+    internal::validateGaussContext(p_gpc, p_context);
+    const Ellipsoid_Geometry_Property &geo = p_context.ellipsoid().geometry;
+    double B = 0.0, L = 0.0;
+    p_context.inverse(p_gpc.x, p_gpc.y, B, L);
+    const double
+        sinB = std::sin(B),
+        k = 1.0 - geo.e1_2 * sinB * sinB,
+        // y^2 / R^2 with R = sqrt(M * N)
+        q2 = p_gpc.y * p_gpc.y * k * k / (geo.a * geo.a * (1.0 - geo.e1_2));
+    return 1.0 +
+           q2 / 2.0 +
+           q2 * q2 / 24.0;
+}
+
 const Gauss_Projector gauss_project{};
 
 M_libga_end
\ No newline at end of file
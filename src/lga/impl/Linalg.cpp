@@ -1,3 +1,9 @@
+#include <vector>
+#include <algorithm>
+
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+
 #include <lga/Linalg>
 
 M_libga_begin
@@ -40,6 +46,86 @@ Matrix normalizedEquation(const Matrix &p_A, const Matrix &p_P)
     }
 }
 
+Matrix normalizedEquation(const Matrix &p_A, const Vector &p_w)
+{
+    return p_A.transpose() * (p_w.asDiagonal() * p_A);
+}
+
+Matrix normalizedEquation(const Matrix &p_A, const Diagonal_Matrix &p_P)
+{
+    return normalizedEquation(p_A, p_P.diagonal());
+}
+
+Sparse_Matrix normalizedEquation(const Sparse_Matrix &p_A, const Vector &p_w)
+{
+    return Sparse_Matrix(p_A.transpose() * p_w.asDiagonal() * p_A);
+}
+
+Vector cofactorDiagonal(const Sparse_Cholesky &p_ldlt)
+{
+    // round trip through row major to get compressed columns with sorted row indices
+    const Eigen::SparseMatrix<double, Eigen::RowMajor> L_row = p_ldlt.matrixL().nestedExpression();
+    const Sparse_Matrix L = L_row;
+    const Vector D = p_ldlt.vectorD();
+    const Eigen::Index size = D.size();
+
+    const int *outer = L.outerIndexPtr(),
+              *inner = L.innerIndexPtr();
+    const double *l = L.valuePtr();
+
+    // Z(i, j), i > j shares the slot of L(i, j)
+    std::vector<double> z(L.nonZeros(), 0.0);
+    Vector z_diag(size);
+
+    auto zAt = [&](int i, int k) -> double
+    {
+        if (i == k)
+        {
+            return z_diag(i);
+        }
+        if (i < k)
+        {
+            std::swap(i, k);
+        }
+        const int *pos = std::lower_bound(inner + outer[k], inner + outer[k + 1], i);
+        return z[pos - inner];
+    };
+
+    for (Eigen::Index j = size - 1; j >= 0; --j)
+    {
+        const int beg = outer[j], end = outer[j + 1];
+        for (int p = beg; p != end; ++p)
+        {
+            double s = 0.0;
+            for (int q = beg; q != end; ++q)
+            {
+                s += l[q] * zAt(inner[p], inner[q]);
+            }
+            z[p] = -s;
+        }
+
+        double s = 0.0;
+        for (int p = beg; p != end; ++p)
+        {
+            s += l[p] * z[p];
+        }
+        z_diag(j) = 1.0 / D(j) - s;
+    }
+
+    const auto &perm = p_ldlt.permutationP();
+    if (perm.size() == 0)
+    {
+        return z_diag;
+    }
+
+    Vector diag(size);
+    for (Eigen::Index i = 0; i != size; ++i)
+    {
+        diag(i) = z_diag(perm.indices()(i));
+    }
+    return diag;
+}
+
 Matrix identityLike(const Matrix &p)
 {
     return Matrix::Identity(p.rows(), p.cols());
@@ -80,6 +166,91 @@ Matrix svdInverse(const Matrix &p)
            svd.matrixU().transpose();
 }
 
+Normal_Equation_Solver::Normal_Equation_Solver(const Matrix &p_n)
+{
+    m_llt.compute(p_n);
+    if (m_llt.info() == Eigen::Success)
+    {
+        m_method = LLT;
+        return;
+    }
+
+    m_ldlt.compute(p_n);
+    if (m_ldlt.info() == Eigen::Success)
+    {
+        m_method = LDLT;
+        return;
+    }
+
+    m_pinv = svdInverse(p_n);
+    m_method = SVD;
+}
+
+Matrix Normal_Equation_Solver::solve(const Matrix &p_rhs) const
+{
+    switch (m_method)
+    {
+    case LLT:
+        return m_llt.solve(p_rhs);
+    case LDLT:
+        return m_ldlt.solve(p_rhs);
+    default:
+        return m_pinv * p_rhs;
+    }
+}
+
+Vector Normal_Equation_Solver::cofactorDiagonal() const
+{
+    const Eigen::Index t = size();
+    switch (m_method)
+    {
+    case LLT:
+    {
+        // Q = L^(-T) * L^(-1), Q(i, i) = |L^(-1) * e_i|^2
+        Matrix Linv = m_llt.matrixL().solve(Matrix::Identity(t, t));
+        return Linv.colwise().squaredNorm().transpose();
+    }
+    case LDLT:
+    {
+        // Q = P.T * L^(-T) * D^(-1) * L^(-1) * P, Q(i, i) = sum((L^(-1) * P * e_i)^2 / D)
+        Matrix LinvP = m_ldlt.transpositionsP() * Matrix::Identity(t, t);
+        m_ldlt.matrixL().solveInPlace(LinvP);
+        return (LinvP.array().square().colwise() / m_ldlt.vectorD().array()).colwise().sum().transpose();
+    }
+    default:
+        return m_pinv.diagonal();
+    }
+}
+
+Matrix Normal_Equation_Solver::cofactorBlock(Eigen::Index p_i, Eigen::Index p_j, Eigen::Index p_rows, Eigen::Index p_cols) const
+{
+    const Eigen::Index t = size();
+    if (p_i < 0 || p_j < 0 || p_rows < 0 || p_cols < 0 || p_i + p_rows > t || p_j + p_cols > t)
+    {
+        matrixBadShape(p_i + p_rows, p_j + p_cols, t, t);
+    }
+
+    if (m_method == SVD)
+    {
+        return m_pinv.block(p_i, p_j, p_rows, p_cols);
+    }
+
+    return solve(Matrix::Identity(t, t).middleCols(p_j, p_cols)).middleRows(p_i, p_rows);
+}
+
+Eigen::Index Normal_Equation_Solver::size() const noexcept
+{
+    switch (m_method)
+    {
+    case LLT:
+        return m_llt.rows();
+    case LDLT:
+        return m_ldlt.rows();
+    default:
+        return m_pinv.rows();
+    }
+}
+
 Matrix ols(const Matrix &p_A, const Matrix &p_L, const Matrix &p_P, std::function<Matrix(const Matrix &)> p_inv_func)
 {
     if (p_P.isIdentity() || isPlaceHolder(p_P))
@@ -88,51 +259,91 @@ Matrix ols(const Matrix &p_A, const Matrix &p_L, const Matrix &p_P, std::functio
     }
     else
     {
-        Matrix AtPAinv = p_inv_func(normalizedEquation(p_A, p_P));
         Matrix AtPL = p_A.transpose() * p_P * p_L;
+        if (!p_inv_func)
+        {
+            return Normal_Equation_Solver(normalizedEquation(p_A, p_P)).solve(AtPL);
+        }
+        Matrix AtPAinv = p_inv_func(normalizedEquation(p_A, p_P));
         return AtPAinv * AtPL;
     }
 }
 
-Matrix xRotation(double p_omega)
+Matrix ols(const Matrix &p_A, const Matrix &p_L, const Vector &p_w, std::function<Matrix(const Matrix &)> p_inv_func)
+{
+    Matrix AtPL = p_A.transpose() * (p_w.asDiagonal() * p_L);
+    if (!p_inv_func)
+    {
+        return Normal_Equation_Solver(normalizedEquation(p_A, p_w)).solve(AtPL);
+    }
+    Matrix AtPAinv = p_inv_func(normalizedEquation(p_A, p_w));
+    return AtPAinv * AtPL;
+}
+
+Matrix ols(const Matrix &p_A, const Matrix &p_L, const Diagonal_Matrix &p_P, std::function<Matrix(const Matrix &)> p_inv_func)
+{
+    return ols(p_A, p_L, p_P.diagonal(), p_inv_func);
+}
+
+Matrix3 xRotation3(double p_omega) noexcept
 {
     const double
         sinw = std::sin(p_omega),
         cosw = std::cos(p_omega);
-    Matrix Rw(3, 3);
+    Matrix3 Rw;
     Rw << 1, 0, 0,
         0, cosw, -sinw,
         0, sinw, cosw;
     return Rw;
 }
 
-Matrix yRotation(double p_phi)
+Matrix3 yRotation3(double p_phi) noexcept
 {
     const double
         sinp = std::sin(p_phi),
         cosp = std::cos(p_phi);
-    Matrix Rp(3, 3);
+    Matrix3 Rp;
     Rp << cosp, 0, -sinp,
         0, 1, 0,
         sinp, 0, cosp;
     return Rp;
 }
 
-Matrix zRotation(double p_kappa)
+Matrix3 zRotation3(double p_kappa) noexcept
 {
     const double
         sink = std::sin(p_kappa),
         cosk = std::cos(p_kappa);
-    Matrix Rk(3, 3);
+    Matrix3 Rk;
     Rk << cosk, -sink, 0,
         sink, cosk, 0,
         0, 0, 1;
     return Rk;
 }
 
+Matrix3 rotationMatrix3(double p_x, double p_y, double p_z) noexcept
+{
+    return xRotation3(p_x) * yRotation3(p_y) * zRotation3(p_z);
+}
+
+Matrix xRotation(double p_omega)
+{
+    return xRotation3(p_omega);
+}
+
+Matrix yRotation(double p_phi)
+{
+    return yRotation3(p_phi);
+}
+
+Matrix zRotation(double p_kappa)
+{
+    return zRotation3(p_kappa);
+}
+
 Matrix rotationMatrix(double p_x, double p_y, double p_z)
 {
-    return xRotation(p_x) * yRotation(p_y) * zRotation(p_z);
+    return rotationMatrix3(p_x, p_y, p_z);
 }
 
 namespace internal
@@ -154,37 +365,159 @@ namespace internal
     }
 }
 
-Matrix translate(const Matrix &p_coord, double p_x, double p_y, double p_z)
+namespace internal
 {
-    internal::validateCoordinateMatrix(p_coord);
+    /**
+     * @brief rows of a chunk handled by one task, small sets run on the calling thread
+     *
+     */
+    constexpr Eigen::Index coordinate_batch_grain = 4096;
+
+    /**
+     * @brief `out = s * (coord - t) * rotate`, columns of a (n, 3) matrix are contiguous so each chunk streams three
+     * arrays through a loop the compiler can vectorize
+     */
+    void affineTransform(
+        const Matrix &p_coord,
+        Matrix &p_out,
+        double p_x, double p_y, double p_z,
+        const Matrix3 &p_rotate,
+        double p_s)
+    {
+        validateCoordinateMatrix(p_coord);
 
-    Matrix translated(p_coord.rows(), p_coord.cols());
+        const Eigen::Index n = p_coord.rows();
+        if (&p_out != &p_coord && (p_out.rows() != n || p_out.cols() != 3))
+        {
+            p_out.resize(n, 3);
+        }
 
-    translated.col(0) = p_coord.col(0).array() - p_x;
-    translated.col(1) = p_coord.col(1).array() - p_y;
-    translated.col(2) = p_coord.col(2).array() - p_z;
+        const Matrix3 M = p_s * p_rotate;
+        const double
+            m00 = M(0, 0), m01 = M(0, 1), m02 = M(0, 2),
+            m10 = M(1, 0), m11 = M(1, 1), m12 = M(1, 2),
+            m20 = M(2, 0), m21 = M(2, 1), m22 = M(2, 2);
+        const double
+            *ix = p_coord.col(0).data(),
+            *iy = p_coord.col(1).data(),
+            *iz = p_coord.col(2).data();
+        double
+            *ox = p_out.col(0).data(),
+            *oy = p_out.col(1).data(),
+            *oz = p_out.col(2).data();
+
+        auto kernel = [=](Eigen::Index p_beg, Eigen::Index p_end)
+        {
+            for (Eigen::Index i = p_beg; i < p_end; ++i)
+            {
+                const double
+                    dx = ix[i] - p_x,
+                    dy = iy[i] - p_y,
+                    dz = iz[i] - p_z;
+                ox[i] = dx * m00 + dy * m10 + dz * m20;
+                oy[i] = dx * m01 + dy * m11 + dz * m21;
+                oz[i] = dx * m02 + dy * m12 + dz * m22;
+            }
+        };
+
+        if (n <= coordinate_batch_grain)
+        {
+            kernel(0, n);
+            return;
+        }
 
+        tbb::parallel_for(
+            tbb::blocked_range<Eigen::Index>(0, n, coordinate_batch_grain),
+            [&](const tbb::blocked_range<Eigen::Index> &p_range)
+            { kernel(p_range.begin(), p_range.end()); });
+    }
+}
+
+Matrix translate(const Matrix &p_coord, double p_x, double p_y, double p_z)
+{
+    Matrix translated;
+    translate(p_coord, translated, p_x, p_y, p_z);
     return translated;
 }
 
 Matrix rotateForward(const Matrix &p_coord, const Matrix &p_rotate)
 {
-    internal::validateCoordinateMatrix(p_coord);
     internal::validateRotationMatrix(p_rotate);
-    return p_coord * p_rotate;
+    Matrix rotated;
+    rotateForward(p_coord, rotated, p_rotate);
+    return rotated;
 }
 
 Matrix rotateInverse(const Matrix &p_coord, const Matrix &p_rotate)
 {
-    internal::validateCoordinateMatrix(p_coord);
     internal::validateRotationMatrix(p_rotate);
-    return p_coord * p_rotate.transpose();
+    Matrix rotated;
+    rotateInverse(p_coord, rotated, p_rotate);
+    return rotated;
 }
 
 Matrix scale(const Matrix &p_coord, double p_s)
 {
-    internal::validateCoordinateMatrix(p_coord);
-    return (p_coord.array() * p_s).matrix();
+    Matrix scaled;
+    scale(p_coord, scaled, p_s);
+    return scaled;
+}
+
+void translate(const Matrix &p_coord, Matrix &p_out, double p_x, double p_y, double p_z)
+{
+    internal::affineTransform(p_coord, p_out, p_x, p_y, p_z, Matrix3::Identity(), 1.0);
+}
+
+void translateInPlace(Matrix &p_coord, double p_x, double p_y, double p_z)
+{
+    translate(p_coord, p_coord, p_x, p_y, p_z);
+}
+
+void rotateForward(const Matrix &p_coord, Matrix &p_out, const Matrix3 &p_rotate)
+{
+    internal::affineTransform(p_coord, p_out, 0.0, 0.0, 0.0, p_rotate, 1.0);
+}
+
+void rotateForwardInPlace(Matrix &p_coord, const Matrix3 &p_rotate)
+{
+    rotateForward(p_coord, p_coord, p_rotate);
+}
+
+void rotateInverse(const Matrix &p_coord, Matrix &p_out, const Matrix3 &p_rotate)
+{
+    internal::affineTransform(p_coord, p_out, 0.0, 0.0, 0.0, p_rotate.transpose(), 1.0);
+}
+
+void rotateInverseInPlace(Matrix &p_coord, const Matrix3 &p_rotate)
+{
+    rotateInverse(p_coord, p_coord, p_rotate);
+}
+
+void scale(const Matrix &p_coord, Matrix &p_out, double p_s)
+{
+    internal::affineTransform(p_coord, p_out, 0.0, 0.0, 0.0, Matrix3::Identity(), p_s);
+}
+
+void scaleInPlace(Matrix &p_coord, double p_s)
+{
+    scale(p_coord, p_coord, p_s);
+}
+
+Matrix similarityTransform(const Matrix &p_coord, const Similarity_Transform_Param &p_param)
+{
+    Matrix transformed;
+    similarityTransform(p_coord, transformed, p_param);
+    return transformed;
+}
+
+void similarityTransform(const Matrix &p_coord, Matrix &p_out, const Similarity_Transform_Param &p_param)
+{
+    internal::affineTransform(p_coord, p_out, p_param.x, p_param.y, p_param.z, p_param.rotate, p_param.s);
+}
+
+void similarityTransformInPlace(Matrix &p_coord, const Similarity_Transform_Param &p_param)
+{
+    similarityTransform(p_coord, p_coord, p_param);
 }
 
 double rmse(
@@ -203,11 +536,34 @@ double rmse(
     }
 }
 
+double rmse(
+    const Matrix &p_v,
+    int n,
+    int t,
+    const Vector &p_w)
+{
+    return std::sqrt((p_v.array().square().colwise() * p_w.array()).sum() / (n - t));
+}
+
+double rmse(
+    const Matrix &p_v,
+    int n,
+    int t,
+    const Diagonal_Matrix &p_P)
+{
+    return rmse(p_v, n, t, p_P.diagonal());
+}
+
 Matrix errorMatrix(double p_rmse, const Matrix &p_n)
 {
     return p_rmse * p_n.cwiseSqrt();
 }
 
+Matrix errorMatrix(double p_rmse, const Normal_Equation_Solver &p_solver)
+{
+    return p_rmse * p_solver.cofactorDiagonal().cwiseSqrt();
+}
+
 namespace fmt
 {
     const Eigen::IOFormat
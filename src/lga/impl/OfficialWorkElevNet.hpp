@@ -11,6 +11,8 @@
 #ifndef M_libga_impl_elev_net
 #define M_libga_impl_elev_net
 
+#include <algorithm>
+
 #include <boost/pending/queue.hpp>
 
 #include <lga/OfficialWork>
@@ -146,9 +148,9 @@ namespace lga
             NT::Vertex_Property_Map::type &vert_prop,
             const NT::Edge_Property_Map::type &edge_prop,
             Net_Indices_Manager<Elev_Net> &nim,
-            Matrix &A,
-            Matrix &P,
-            Matrix &L,
+            std::vector<Sparse_Triplet> &A,
+            Vector &P,
+            Vector &L,
             double unit_w)
             : m_self_loop_detected(false),
               m_vert_prop(vert_prop),
@@ -176,7 +178,7 @@ namespace lga
         }
 
         /**
-         * @brief initialize each vertex and update matrix(A, L, P) based on each out edge
+         * @brief initialize each vertex and emit coefficient triplets of A, weight and residual based on each out edge
          *
          * @tparam Edge
          * @tparam Graph
@@ -208,28 +210,27 @@ namespace lga
             std::println("\tu [{}:{}], elev = {}, is_control = {}, is_init = {}", up.name, m_nim.getvi(u), up.elev, up.is_control, up.is_init);
             std::println("\tv [{}:{}], elev = {}, is_control = {}, is_init = {}", vp.name, m_nim.getvi(v), vp.elev, vp.is_control, vp.is_init);
 #endif
-            // update weight matrix
-            m_P(ei, ei) = m_unit_weight / ep.len;
+            // update weight
+            m_P(ei) = m_unit_weight / ep.len;
             m_nim.putei(e, ei);
 
-            // update coefficient and residual matrix
-            auto A = m_A.row(ei);
-            auto L = m_L.row(ei);
+            // update coefficient and residual
+            double &L = m_L(ei);
 
-            L(0) += ep.diff;
-            L(0) += up.elev;
-            L(0) -= vp.elev;
+            L += ep.diff;
+            L += up.elev;
+            L -= vp.elev;
 
             if (!up.is_control)
             {
-                A(m_nim.getvi(u)) = -1;
+                m_A.emplace_back(ei, m_nim.getvi(u), -1.0);
             }
             if (!vp.is_control)
             {
-                A(m_nim.getvi(v)) = 1;
+                m_A.emplace_back(ei, m_nim.getvi(v), 1.0);
             }
 
-            L(0) *= 1000;
+            L *= 1000;
 
             ei += 1;
         }
@@ -241,7 +242,8 @@ namespace lga
         NT::Vertex_Property_Map::type &m_vert_prop;
         const NT::Edge_Property_Map::type &m_edge_prop;
         Net_Indices_Manager<Elev_Net> &m_nim;
-        Matrix &m_A, &m_P, &m_L;
+        std::vector<Sparse_Triplet> &m_A;
+        Vector &m_P, &m_L;
         double m_unit_weight;
         mutable std::size_t ei = 0;
     };
@@ -292,12 +294,14 @@ namespace lga
         auto vert_color = boost::make_iterator_property_map(
             colors.begin(),
             boost::get(boost::vertex_index, net));
-        Matrix
-            A = Matrix::Zero(n, t),
-            P = Matrix::Zero(n, n),
-            L = Matrix::Zero(n, 1);
-
-        Elev_Net_Visitor visitor(vert_prop, edge_prop, nim, A, P, L, unit_w);
+        // each observation touches at most 2 temporary vertices, A and P are kept sparse
+        std::vector<Sparse_Triplet> A_triplets;
+        A_triplets.reserve(2 * n);
+        Vector
+            P = Vector::Zero(n),
+            L = Vector::Zero(n);
+
+        Elev_Net_Visitor visitor(vert_prop, edge_prop, nim, A_triplets, P, L, unit_w);
         boost::breadth_first_search(net, seeds.begin(), seeds.end(), buffer, visitor, vert_color);
 
         if (!visitor.isValid())
@@ -305,15 +309,27 @@ namespace lga
             throw std::invalid_argument("self loop detected");
         }
 
-        Matrix AtAi = choleskyInverse(normalizedEquation(A, P));
-        Matrix AtPL = A.transpose() * P * L;
-        Matrix x = AtAi * AtPL / 1000;
-        Matrix V = A * x - L / 1000;
+        Sparse_Matrix A(n, t);
+        A.setFromTriplets(A_triplets.begin(), A_triplets.end());
+
+        Sparse_Cholesky ldlt(normalizedEquation(A, P));
+        if (ldlt.info() != Eigen::Success)
+        {
+            throw std::invalid_argument("normal equation of net is singular");
+        }
+
+        Vector x = ldlt.solve(A.transpose() * P.asDiagonal() * L) / 1000;
+        Vector V = A * x - L / 1000;
 
 #if (M_libga_debug)
-        std::cout << "> A:\n"
-                  << A.format(fmt::python) << "\n"
-                  << "> P:\n"
+        // A may be far too large to print densely, only its shape and first few non-zeros are shown
+        std::cout << std::format("> A: ({:d}, {:d}), nnz = {:d}\n", A.rows(), A.cols(), A.nonZeros());
+        for (size_t i = 0; i != std::min<size_t>(A_triplets.size(), 8); ++i)
+        {
+            std::cout << std::format(
+                "  ({:d}, {:d}) = {}\n", A_triplets[i].row(), A_triplets[i].col(), A_triplets[i].value());
+        }
+        std::cout << "> P:\n"
                   << P.format(fmt::python) << "\n"
                   << "> L:\n"
                   << L.format(fmt::python) << "\n"
@@ -346,7 +362,7 @@ namespace lga
         }
 
         r.rmse = rmse(V, n, t, P);
-        r.sigma = errorMatrix(r.rmse, AtAi);
+        r.std_error = errorMatrix(r.rmse, cofactorDiagonal(ldlt));
 
 #if (M_libga_debug)
         {
@@ -1,4 +1,11 @@
+#include <chrono>
+#include <algorithm>
+
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+
 #include <lga/Photogrammetry>
+#include <lga/impl/PhotogrammetryPoint.hpp>
 
 M_libga_begin
 
@@ -14,10 +21,35 @@ M_libga_begin
         .kappa = 0.0};
 }
 
+Exterior
+Exterior::makeFrom(const Vector3 &p_center, const Matrix3 &p_rotate) noexcept
+{
+    // R = Ry(phi) * Rx(omega) * Rz(kappa)
+    return Exterior{
+        .x = p_center.x(),
+        .y = p_center.y(),
+        .z = p_center.z(),
+        .phi = std::atan2(-p_rotate(0, 2), p_rotate(2, 2)),
+        .omega = std::asin(std::clamp(-p_rotate(1, 2), -1.0, 1.0)),
+        .kappa = std::atan2(p_rotate(1, 0), p_rotate(1, 1))};
+}
+
+Matrix3
+ex2yxzRotation3(const Exterior &p_ex) noexcept
+{
+    return yRotation3(p_ex.phi) * xRotation3(p_ex.omega) * zRotation3(p_ex.kappa);
+}
+
 Matrix
 ex2yxzRotation(const Exterior &p_ex)
 {
-    return yRotation(p_ex.phi) * xRotation(p_ex.omega) * zRotation(p_ex.kappa);
+    return ex2yxzRotation3(p_ex);
+}
+
+Quaternion
+ex2quaternion(const Exterior &p_ex) noexcept
+{
+    return Quaternion(ex2yxzRotation3(p_ex));
 }
 
 Matrix
@@ -36,6 +68,12 @@ xyz2mat31(
     m << p_x, p_y, p_z;
     return m;
 }
+Vector3
+xyz2vec3(
+    double p_x, double p_y, double p_z) noexcept
+{
+    return Vector3(p_x, p_y, p_z);
+}
 Matrix
 xy2mat12(
     double p_x, double p_y)
@@ -84,7 +122,132 @@ isp2img(
     const double f = p_in.f;
     img.col(0) = -f * (XBar / ZBar).matrix(); // x
     img.col(1) = -f * (YBar / ZBar).matrix(); // y
-    return img;
+    return p_in.undistortion ? distort(img, p_in.undistortion->distortion()) : img;
+}
+
+Vector3
+obj2isp3(
+    const Vector3 &p_obj, const Exterior &p_ex, const Matrix3 &p_rotate) noexcept
+{
+    return p_rotate.transpose() * (p_obj - Vector3(p_ex.x, p_ex.y, p_ex.z));
+}
+Vector2
+isp2img3(
+    const Vector3 &p_isp, const Interior &p_in) noexcept
+{
+    const double f_z = -p_in.f / p_isp.z();
+    const Vector2 img(f_z * p_isp.x(), f_z * p_isp.y());
+    return p_in.undistortion ? distort3(img, p_in.undistortion->distortion()) : img;
+}
+Vector2
+obj2img3(
+    const Vector3 &p_obj,
+    const Exterior &p_ex,
+    const Interior &p_in, const Matrix3 &p_rotate) noexcept
+{
+    return isp2img3(obj2isp3(p_obj, p_ex, p_rotate), p_in);
+}
+Vector3
+isp2aux3(
+    const Vector3 &p_isp, const Matrix3 &p_rotate) noexcept
+{
+    return p_rotate * p_isp;
+}
+
+namespace internal
+{
+    /**
+     * @brief rows of a chunk handled by one task in `obj2imgSoA`
+     *
+     */
+    constexpr size_t projection_batch_grain = 8192;
+
+    /**
+     * @brief `img = -f * (R.T * (obj - S)).xy / (R.T * (obj - S)).z`, rotation is spread into scalars so the loop
+     * body has no dependency between points and the compiler can vectorize it. Lens distortion runs as a second pass
+     * over the chunk.
+     */
+    void obj2imgKernel(
+        const double *p_x, const double *p_y, const double *p_z,
+        double *p_img_x, double *p_img_y,
+        size_t p_beg, size_t p_end,
+        const Exterior &p_ex,
+        const Interior &p_in,
+        const Matrix3 &p_rotate) noexcept
+    {
+        const double
+            r00 = p_rotate(0, 0), r01 = p_rotate(0, 1), r02 = p_rotate(0, 2),
+            r10 = p_rotate(1, 0), r11 = p_rotate(1, 1), r12 = p_rotate(1, 2),
+            r20 = p_rotate(2, 0), r21 = p_rotate(2, 1), r22 = p_rotate(2, 2),
+            xs = p_ex.x, ys = p_ex.y, zs = p_ex.z,
+            neg_f = -p_in.f;
+
+        for (size_t i = p_beg; i < p_end; ++i)
+        {
+            const double
+                dx = p_x[i] - xs,
+                dy = p_y[i] - ys,
+                dz = p_z[i] - zs,
+                u = r00 * dx + r10 * dy + r20 * dz,
+                v = r01 * dx + r11 * dy + r21 * dz,
+                w = r02 * dx + r12 * dy + r22 * dz,
+                s = neg_f / w;
+            p_img_x[i] = s * u;
+            p_img_y[i] = s * v;
+        }
+
+        if (p_in.undistortion)
+        {
+            const Lens_Distortion &distortion = p_in.undistortion->distortion();
+            for (size_t i = p_beg; i < p_end; ++i)
+            {
+                const Vector2 img = distort3(Vector2(p_img_x[i], p_img_y[i]), distortion);
+                p_img_x[i] = img.x();
+                p_img_y[i] = img.y();
+            }
+        }
+    }
+}
+
+void obj2imgSoA(
+    std::span<const double> p_x,
+    std::span<const double> p_y,
+    std::span<const double> p_z,
+    const Exterior &p_ex,
+    const Interior &p_in,
+    const Matrix3 &p_rotate,
+    std::span<double> p_img_x,
+    std::span<double> p_img_y)
+{
+    const size_t n = p_x.size();
+    if (!(p_y.size() == n && p_z.size() == n && p_img_x.size() == n && p_img_y.size() == n))
+    {
+        throw std::invalid_argument(
+            std::format(
+                "array sizes don't match: x {:d}, y {:d}, z {:d}, img_x {:d}, img_y {:d}",
+                n, p_y.size(), p_z.size(), p_img_x.size(), p_img_y.size()));
+    }
+
+    const double
+        *x = p_x.data(),
+        *y = p_y.data(),
+        *z = p_z.data();
+    double
+        *img_x = p_img_x.data(),
+        *img_y = p_img_y.data();
+
+    if (n <= internal::projection_batch_grain)
+    {
+        internal::obj2imgKernel(x, y, z, img_x, img_y, 0, n, p_ex, p_in, p_rotate);
+        return;
+    }
+
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, n, internal::projection_batch_grain),
+        [&](const tbb::blocked_range<size_t> &p_range)
+        {
+            internal::obj2imgKernel(x, y, z, img_x, img_y, p_range.begin(), p_range.end(), p_ex, p_in, p_rotate);
+        });
 }
 
 Matrix
@@ -93,7 +256,17 @@ obj2img(
     const Exterior &p_ex,
     const Interior &p_in, const Matrix &p_rotate)
 {
-    return isp2img(aux2isp(obj2aux(p_obj, p_ex), p_rotate), p_in);
+    internal::validateCoordinateMatrix(p_obj);
+    internal::validateRotationMatrix(p_rotate);
+
+    // columns of column-major matrices are already structure of arrays
+    const size_t n = p_obj.rows();
+    Matrix img(n, 2);
+    obj2imgSoA(
+        {p_obj.col(0).data(), n}, {p_obj.col(1).data(), n}, {p_obj.col(2).data(), n},
+        p_ex, p_in, Matrix3(p_rotate),
+        {img.col(0).data(), n}, {img.col(1).data(), n});
+    return img;
 }
 Matrix
 obj2img(
@@ -121,7 +294,115 @@ Matrix
 aux2obj(
     const Matrix &p_aux, const Exterior &p_ex)
 {
-    return translate(p_aux, p_ex.x, p_ex.y, p_ex.z);
+    return translate(p_aux, -p_ex.x, -p_ex.y, -p_ex.z);
+}
+
+Oriented_Image::Oriented_Image(const Image_Meta_Data &p_meta)
+    : m_exterior(p_meta.exterior),
+      m_interior(p_meta.interior),
+      m_rotate(ex2yxzRotation3(p_meta.exterior)),
+      m_rotate_t(m_rotate.transpose()),
+      m_center(p_meta.exterior.x, p_meta.exterior.y, p_meta.exterior.z)
+{
+}
+
+const Exterior &Oriented_Image::exterior() const noexcept
+{
+    return m_exterior;
+}
+
+const Interior &Oriented_Image::interior() const noexcept
+{
+    return m_interior;
+}
+
+Image_Meta_Data Oriented_Image::meta() const noexcept
+{
+    return {m_exterior, m_interior};
+}
+
+const Matrix3 &Oriented_Image::rotate() const noexcept
+{
+    return m_rotate;
+}
+
+const Matrix3 &Oriented_Image::rotateTranspose() const noexcept
+{
+    return m_rotate_t;
+}
+
+const Vector3 &Oriented_Image::center() const noexcept
+{
+    return m_center;
+}
+
+Vector3 Oriented_Image::obj2isp(const Vector3 &p_obj) const noexcept
+{
+    return m_rotate_t * (p_obj - m_center);
+}
+
+Vector2 Oriented_Image::obj2img(const Vector3 &p_obj) const noexcept
+{
+    return isp2img3(obj2isp(p_obj), m_interior);
+}
+
+Vector3 Oriented_Image::img2aux(const Vector2 &p_img) const noexcept
+{
+    const Vector2 img = m_interior.undistortion ? m_interior.undistortion->undistort3(p_img) : p_img;
+    return m_rotate * Vector3(img.x(), img.y(), -m_interior.f);
+}
+
+Matrix
+obj2aux(const Matrix &p_obj, const Oriented_Image &p_image)
+{
+    return obj2aux(p_obj, p_image.exterior());
+}
+
+Matrix
+aux2isp(const Matrix &p_aux, const Oriented_Image &p_image)
+{
+    Matrix isp;
+    rotateForward(p_aux, isp, p_image.rotate());
+    return isp;
+}
+
+Matrix
+isp2aux(const Matrix &p_isp, const Oriented_Image &p_image)
+{
+    Matrix aux;
+    rotateInverse(p_isp, aux, p_image.rotate());
+    return aux;
+}
+
+Matrix
+aux2obj(const Matrix &p_aux, const Oriented_Image &p_image)
+{
+    return aux2obj(p_aux, p_image.exterior());
+}
+
+Matrix
+obj2img(const Matrix &p_obj, const Oriented_Image &p_image)
+{
+    internal::validateCoordinateMatrix(p_obj);
+
+    const size_t n = p_obj.rows();
+    Matrix img(n, 2);
+    obj2imgSoA(
+        {p_obj.col(0).data(), n}, {p_obj.col(1).data(), n}, {p_obj.col(2).data(), n},
+        p_image,
+        {img.col(0).data(), n}, {img.col(1).data(), n});
+    return img;
+}
+
+void obj2imgSoA(
+    std::span<const double> p_x,
+    std::span<const double> p_y,
+    std::span<const double> p_z,
+    const Oriented_Image &p_image,
+    std::span<double> p_img_x,
+    std::span<double> p_img_y)
+{
+    obj2imgSoA(p_x, p_y, p_z, p_image.exterior(), p_image.interior(), p_image.rotate(), p_img_x, p_img_y);
 }
 
 Matrix
@@ -133,6 +414,31 @@ Collinearity_Condition_Equation_Coefficient::toMatrix26() const noexcept
     return mat;
 }
 
+Vector6
+Collinearity_Condition_Equation_Coefficient::row1() const noexcept
+{
+    return (Vector6() << a11, a12, a13, a14, a15, a16).finished();
+}
+
+Vector6
+Collinearity_Condition_Equation_Coefficient::row2() const noexcept
+{
+    return (Vector6() << a21, a22, a23, a24, a25, a26).finished();
+}
+
+void Collinearity_Condition_Equation_Coefficient::accumulate26(
+    Matrix6 &p_normal,
+    Vector6 &p_rhs,
+    double p_lx,
+    double p_ly) const noexcept
+{
+    const Vector6
+        r1 = row1(),
+        r2 = row2();
+    p_normal.noalias() += r1 * r1.transpose() + r2 * r2.transpose();
+    p_rhs.noalias() += r1 * p_lx + r2 * p_ly;
+}
+
 Matrix
 Collinearity_Condition_Equation_Coefficient::toMatrix29() const noexcept
 {
@@ -241,122 +547,261 @@ cceSimplifyNone(
             .a26 = -x};
     return coeff;
 }
+Collinearity_Condition_Equation_Coefficient
+cceIncremental(const Vector3 &p_isp, double p_f, const Matrix3 &p_rotate) noexcept
+{
+    const double
+        z = p_isp.z(),
+        f_z = -p_f / z,
+        x = f_z * p_isp.x(),
+        y = f_z * p_isp.y(),
+        xy_f = x * y / p_f;
 
-Space_Resection_Result
-spaceResection(
-    const Interior &p_in,
-    const Matrix &p_img,
-    const Matrix &p_obj,
-    size_t p_max_loop,
-    double p_threshold,
-    Collinearity_Condition_Equation_Coefficient_Solver p_cce_solver,
-    Matrix_Inverse_Solver p_inverse_solver)
+    Collinearity_Condition_Equation_Coefficient
+        coeff{
+            .a11 = 1 / z * (p_rotate(0, 0) * p_f + p_rotate(0, 2) * x),
+            .a12 = 1 / z * (p_rotate(1, 0) * p_f + p_rotate(1, 2) * x),
+            .a13 = 1 / z * (p_rotate(2, 0) * p_f + p_rotate(2, 2) * x),
+            .a14 = -xy_f,
+            .a15 = p_f + x * x / p_f,
+            .a16 = y,
+            .a21 = 1 / z * (p_rotate(0, 1) * p_f + p_rotate(0, 2) * y),
+            .a22 = 1 / z * (p_rotate(1, 1) * p_f + p_rotate(1, 2) * y),
+            .a23 = 1 / z * (p_rotate(2, 1) * p_f + p_rotate(2, 2) * y),
+            .a24 = -p_f - y * y / p_f,
+            .a25 = xy_f,
+            .a26 = -x};
+    return coeff;
+}
+
+namespace internal
 {
-    if (!(
-            p_img.rows() == p_obj.rows() &&
-            p_img.cols() == 2 &&
-            p_obj.cols() == 3))
+    /**
+     * @brief levenberg marquardt step, tries `(N + lambda * diag(N)) * dx = u` until squared residuals at `dx` given
+     * by `p_cost_at` are less than `p_cost`. Returns false if all tries are rejected, `p_dx` is then the least damped
+     * try, which callers compare with their threshold to tell a reached minimum from a stalled solve.
+     *
+     */
+    template <typename Normal, typename Rhs, typename Cost>
+    bool dampedStep(
+        const Normal &p_normal,
+        const Rhs &p_rhs,
+        double p_cost,
+        Cost &&p_cost_at,
+        double &p_lambda,
+        const Iterative_Step_Option &p_step,
+        Rhs &p_dx)
     {
-        throw std::invalid_argument(
-            std::format(
-                "matrix shape does't satisfy rules: {:d} == {:d} && {:d} == 2 && {:d} == 3",
-                p_img.rows(),
-                p_obj.rows(),
-                p_img.cols(),
-                p_obj.cols()));
+        for (size_t attempt = 0; attempt <= p_step.max_reject; ++attempt)
+        {
+            Normal damped = p_normal;
+            damped.diagonal() += p_lambda * p_normal.diagonal();
+            const Rhs dx = damped.ldlt().solve(p_rhs);
+            if (attempt == 0)
+            {
+                p_dx = dx;
+            }
+            if (p_cost_at(dx) < p_cost)
+            {
+                p_lambda *= p_step.lambda_down;
+                p_dx = dx;
+                return true;
+            }
+            p_lambda *= p_step.lambda_up;
+        }
+        return false;
     }
 
-    if (!(p_img.rows() >= 4))
+    void validateSpaceResectionInput(const Matrix &p_img, const Matrix &p_obj)
     {
-        throw std::invalid_argument(
-            std::format(
-                "`{:d}` points are not enough for space resection",
-                p_img.rows()));
+        if (!(
+                p_img.rows() == p_obj.rows() &&
+                p_img.cols() == 2 &&
+                p_obj.cols() == 3))
+        {
+            throw std::invalid_argument(
+                std::format(
+                    "matrix shape does't satisfy rules: {:d} == {:d} && {:d} == 2 && {:d} == 3",
+                    p_img.rows(),
+                    p_obj.rows(),
+                    p_img.cols(),
+                    p_obj.cols()));
+        }
+
+        if (!(p_img.rows() >= 4))
+        {
+            throw std::invalid_argument(
+                std::format(
+                    "`{:d}` points are not enough for space resection",
+                    p_img.rows()));
+        }
     }
 
-    Space_Resection_Result result{
-        .exterior{Exterior::makeFrom(p_in, p_obj)},
-        .info{Iterative_Algo_Info::NOT_CONVERGED}};
+    Space_Resection_Result
+    spaceResection(
+        const Interior &p_in,
+        const Matrix &p_img,
+        const Matrix &p_obj,
+        size_t p_max_loop,
+        double p_threshold,
+        Collinearity_Condition_Equation_Coefficient_Solver p_cce_solver,
+        Matrix_Inverse_Solver p_inverse_solver,
+        const Exterior_Initializer &p_initializer,
+        const Iterative_Step_Option &p_step,
+        Rotation_Parameterization p_rotation)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        const bool incremental = p_rotation == Rotation_Parameterization::INCREMENTAL_QUATERNION;
+
+        Space_Resection_Result result{
+            .exterior{p_initializer(p_in, p_img, p_obj)},
+            .info{Iterative_Algo_Info::NOT_CONVERGED}};
 
-    Exterior &exterior = result.exterior;
+        Exterior &exterior = result.exterior;
+        Quaternion quaternion = ex2quaternion(exterior);
 
-    while (p_max_loop-- > 0)
-    {
-        Matrix
-            rotate{ex2yxzRotation(exterior)},
-            isp{aux2isp(obj2aux(p_obj, exterior), rotate)},
-            img_calc{isp2img(isp, p_in)},
-            dxy = p_img - img_calc;
-
-        Matrix residual(p_img.rows() * 2, 1);
-        for (long int li = 0; li != dxy.rows(); ++li)
+        // q * dq with dq = [1, d / 2] normalized, first order of exp([d]x) and exact as d vanishes
+        auto rotated = [&quaternion](const Vector6 &p_dx)
         {
-            residual(2 * li) = dxy(li, 0);
-            residual(2 * li + 1) = dxy(li, 1);
-        }
+            return (quaternion * Quaternion(1.0, 0.5 * p_dx(3), 0.5 * p_dx(4), 0.5 * p_dx(5))).normalized();
+        };
 
-        Matrix coefficient(p_img.rows() * 2, 6);
+        Matrix6 normal;
+        Vector6 rhs;
+        Matrix3 rotate3;
+        Matrix rotate(3, 3);
         Collinearity_Condition_Equation_Linearization_Param
             cce_param{
                 .f = p_in.f,
                 .h = p_in.f * p_in.m,
-                .kappa = exterior.kappa,
-                .omega = exterior.omega,
                 .rotate = rotate};
-        for (long int pi = 0; pi != img_calc.rows(); ++pi)
+
+        auto linearize = [&](long int pi, Vector2 &p_l)
         {
-            cce_param.x = img_calc(pi, 0);
-            cce_param.y = img_calc(pi, 1);
-            cce_param.z = isp(pi, 2);
-
-            Collinearity_Condition_Equation_Coefficient
-                c = p_cce_solver(cce_param);
-            coefficient.row(pi * 2) << c.a11, c.a12, c.a13, c.a14, c.a15, c.a16;
-            coefficient.row(pi * 2 + 1) << c.a21, c.a22, c.a23, c.a24, c.a25, c.a26;
-        }
+            const Vector3 isp = obj2isp3(p_obj.row(pi).transpose(), exterior, rotate3);
+            const Vector2 img_calc = isp2img3(isp, p_in);
 
-        Matrix correction{ols(coefficient, residual)};
+            p_l << p_img(pi, 0) - img_calc.x(), p_img(pi, 1) - img_calc.y();
 
-        if (std::abs(correction(3)) < p_threshold &&
-            std::abs(correction(4)) < p_threshold &&
-            std::abs(correction(5)) < p_threshold)
+            if (incremental)
+            {
+                return cceIncremental(isp, p_in.f, rotate3);
+            }
+            cce_param.x = img_calc.x();
+            cce_param.y = img_calc.y();
+            cce_param.z = isp.z();
+            return p_cce_solver(cce_param);
+        };
+
+        double lambda = p_step.lambda;
+        auto cost_at = [&](const Vector6 &p_dx)
         {
-            Matrix v = coefficient * correction - residual;
-            Matrix n_inv = p_inverse_solver(coefficient.transpose() * coefficient);
-            result.rmse = rmse(v, coefficient.rows(), 6);
-            result.sigma = errorMatrix(result.rmse, n_inv);
-            result.image = Matrix(p_img);
-            result.rotate = Matrix(rotate);
-            Matrix &p = result.image;
-            for (size_t pc = coefficient.rows() / 2, pi = 0uz; pi != pc; ++pi)
+            const Exterior trial{
+                exterior.x + p_dx(0), exterior.y + p_dx(1), exterior.z + p_dx(2),
+                exterior.phi + p_dx(3), exterior.omega + p_dx(4), exterior.kappa + p_dx(5)};
+            const Matrix3 trial_rotate = incremental ? rotated(p_dx).toRotationMatrix() : ex2yxzRotation3(trial);
+            double sse = 0.0;
+            for (long int pi = 0; pi != p_img.rows(); ++pi)
             {
-                p(pi, 0) = (p(pi, 0) + v(2 * pi)) * 1000;
-                p(pi, 1) = (p(pi, 1) + v(2 * pi + 1)) * 1000;
+                sse += (p_img.row(pi).transpose() -
+                        obj2img3(p_obj.row(pi).transpose(), trial, p_in, trial_rotate))
+                           .squaredNorm();
+            }
+            return sse;
+        };
+
+        while (p_max_loop-- > 0)
+        {
+            ++result.iterations;
+            rotate3 = incremental ? quaternion.toRotationMatrix() : ex2yxzRotation3(exterior);
+            rotate = rotate3;
+            cce_param.kappa = exterior.kappa;
+            cce_param.omega = exterior.omega;
+
+            normal.setZero();
+            rhs.setZero();
+            double ltl = 0.0;
+            for (long int pi = 0; pi != p_img.rows(); ++pi)
+            {
+                Vector2 l;
+                linearize(pi, l).accumulate26(normal, rhs, l.x(), l.y());
+                ltl += l.squaredNorm();
+            }
+
+            Vector6 correction;
+            bool accepted = true;
+            if (p_step.method == Iterative_Step_Method::LEVENBERG_MARQUARDT)
+            {
+                accepted = internal::dampedStep(normal, rhs, ltl, cost_at, lambda, p_step, correction);
+            }
+            else
+            {
+                correction = normal.ldlt().solve(rhs);
+            }
+
+            result.telemetry.rmse.push_back(std::sqrt(ltl / (2.0 * p_img.rows() - 6.0)));
+            result.telemetry.correction_norm.push_back(correction.norm());
+            result.telemetry.lambda.push_back(
+                p_step.method == Iterative_Step_Method::LEVENBERG_MARQUARDT ? lambda : 0.0);
+
+            if (!accepted)
+            {
+                // every damped try is rejected: a step below threshold means the minimum is reached and rounding
+                // keeps residuals from decreasing, otherwise the solve is stalled and stays `NOT_CONVERGED`
+                if (!(correction.tail<3>().cwiseAbs().maxCoeff() < p_threshold))
+                {
+                    break;
+                }
+                correction.setZero();
+            }
+
+            if (std::abs(correction(3)) < p_threshold &&
+                std::abs(correction(4)) < p_threshold &&
+                std::abs(correction(5)) < p_threshold)
+            {
+                Matrix v(p_img.rows() * 2, 1);
+                for (long int pi = 0; pi != p_img.rows(); ++pi)
+                {
+                    Vector2 l;
+                    const Collinearity_Condition_Equation_Coefficient c = linearize(pi, l);
+                    v(2 * pi) = c.row1().dot(correction) - l.x();
+                    v(2 * pi + 1) = c.row2().dot(correction) - l.y();
+                }
+
+                result.rmse = rmse(v, v.rows(), 6);
+                const Matrix cofactor = p_inverse_solver
+                                            ? p_inverse_solver(Matrix(normal))
+                                            : Normal_Equation_Solver(Matrix(normal)).cofactorBlock(0, 0, 6, 6);
+                result.sigma = errorMatrix(result.rmse, cofactor);
+                result.std_error = result.rmse * cofactor.diagonal().cwiseSqrt();
+                result.image = Matrix(p_img);
+                result.rotate = Matrix(rotate);
+                Matrix &p = result.image;
+                for (long int pi = 0; pi != p.rows(); ++pi)
+                {
+                    p(pi, 0) = (p(pi, 0) + v(2 * pi)) * 1000;
+                    p(pi, 1) = (p(pi, 1) + v(2 * pi + 1)) * 1000;
+                }
+                result.info = Iterative_Algo_Info::SUCCESS;
+                break;
             }
-            result.info = Iterative_Algo_Info::SUCCESS;
-            break;
-        }
 
 #if (M_libga_debug)
-        Eigen::IOFormat fmt(Eigen::FullPrecision, 0, ", ", ";\n", "[", "]", "[", "]");
-        std::cout << "\nrotate\n"
-                  << rotate.format(fmt)
-                  << "\nobj\n"
-                  << p_obj.format(fmt)
-                  << "\nisp\n"
-                  << isp.format(fmt)
-                  << "\nimg_calc\n"
-                  << img_calc.format(fmt)
-                  << "\nresidual\n"
-                  << residual.format(fmt)
-                  << "\ncoefficient\n"
-                  << coefficient.format(fmt)
-                  << "\ncorrection\n"
-                  << correction.format(fmt)
-                  << std::endl;
-
-        std::println(
-            R"(
+            Eigen::IOFormat fmt(Eigen::FullPrecision, 0, ", ", ";\n", "[", "]", "[", "]");
+            std::cout << "\nrotate\n"
+                      << rotate.format(fmt)
+                      << "\nobj\n"
+                      << p_obj.format(fmt)
+                      << "\nnormal\n"
+                      << normal.format(fmt)
+                      << "\nrhs\n"
+                      << rhs.format(fmt)
+                      << "\ncorrection\n"
+                      << correction.format(fmt)
+                      << std::endl;
+
+            std::println(
+                R"(
 exterior :
     x = {:.5f}
     y = {:.5f}
@@ -365,23 +810,113 @@ exterior :
     omega = {:.5f}
     kappa = {:.5f}
     )",
-            exterior.x,
-            exterior.y,
-            exterior.z,
-            exterior.phi,
-            exterior.omega,
-            exterior.kappa);
+                exterior.x,
+                exterior.y,
+                exterior.z,
+                exterior.phi,
+                exterior.omega,
+                exterior.kappa);
 #endif
 
-        exterior.x += correction(0);
-        exterior.y += correction(1);
-        exterior.z += correction(2);
-        exterior.phi += correction(3);
-        exterior.omega += correction(4);
-        exterior.kappa += correction(5);
+            if (incremental)
+            {
+                quaternion = rotated(correction);
+                exterior = Exterior::makeFrom(
+                    Vector3(exterior.x + correction(0), exterior.y + correction(1), exterior.z + correction(2)),
+                    quaternion.toRotationMatrix());
+                continue;
+            }
+            exterior.x += correction(0);
+            exterior.y += correction(1);
+            exterior.z += correction(2);
+            exterior.phi += correction(3);
+            exterior.omega += correction(4);
+            exterior.kappa += correction(5);
+        }
+
+        result.elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        return result;
     }
+}
 
-    return result;
+Space_Resection_Result
+spaceResection(
+    const Interior &p_in,
+    const Matrix &p_img,
+    const Matrix &p_obj,
+    size_t p_max_loop,
+    double p_threshold,
+    Collinearity_Condition_Equation_Coefficient_Solver p_cce_solver,
+    Matrix_Inverse_Solver p_inverse_solver,
+    Exterior_Initializer p_initializer,
+    Iterative_Step_Option p_step,
+    Rotation_Parameterization p_rotation)
+{
+    internal::validateSpaceResectionInput(p_img, p_obj);
+    return internal::spaceResection(
+        internal::idealInterior(p_in), internal::undistortImage(p_in, p_img), p_obj, p_max_loop, p_threshold, p_cce_solver, p_inverse_solver, p_initializer, p_step,
+        p_rotation);
+}
+
+Space_Resection_Result
+spaceResection(
+    const Oriented_Image &p_initial,
+    const Matrix &p_img,
+    const Matrix &p_obj,
+    size_t p_max_loop,
+    double p_threshold,
+    Collinearity_Condition_Equation_Coefficient_Solver p_cce_solver,
+    Matrix_Inverse_Solver p_inverse_solver,
+    Iterative_Step_Option p_step,
+    Rotation_Parameterization p_rotation)
+{
+    return spaceResection(
+        p_initial.interior(), p_img, p_obj, p_max_loop, p_threshold, p_cce_solver, p_inverse_solver,
+        [&p_initial](const Interior &, const Matrix &, const Matrix &)
+        { return p_initial.exterior(); },
+        p_step, p_rotation);
+}
+
+std::vector<Space_Resection_Result>
+batchSpaceResection(
+    std::span<const Space_Resection_Job> p_jobs,
+    size_t p_max_loop,
+    double p_threshold,
+    Collinearity_Condition_Equation_Coefficient_Solver p_cce_solver,
+    Matrix_Inverse_Solver p_inverse_solver,
+    Exterior_Initializer p_initializer,
+    Iterative_Step_Option p_step,
+    Rotation_Parameterization p_rotation)
+{
+    for (size_t ji = 0; ji != p_jobs.size(); ++ji)
+    {
+        try
+        {
+            internal::validateSpaceResectionInput(p_jobs[ji].image, p_jobs[ji].object);
+        }
+        catch (const std::invalid_argument &e)
+        {
+            throw std::invalid_argument(std::format("job {:d}: {}", ji, e.what()));
+        }
+    }
+
+    std::vector<Space_Resection_Result> results(p_jobs.size());
+
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, p_jobs.size()),
+        [&](const tbb::blocked_range<size_t> &p_range)
+        {
+            for (size_t ji = p_range.begin(); ji != p_range.end(); ++ji)
+            {
+                const Space_Resection_Job &job = p_jobs[ji];
+                results[ji] = internal::spaceResection(
+                    internal::idealInterior(job.interior), internal::undistortImage(job.interior, job.image),
+                    job.object,
+                    p_max_loop, p_threshold, p_cce_solver, p_inverse_solver, p_initializer, p_step, p_rotation);
+            }
+        });
+
+    return results;
 }
 
 Matrix
@@ -390,22 +925,32 @@ spaceIntersection(
     const Matrix &p_left_img,
     const Image_Meta_Data &p_right_meta,
     const Matrix &p_right_img)
+{
+    return spaceIntersection(Oriented_Image(p_left_meta), p_left_img, Oriented_Image(p_right_meta), p_right_img);
+}
+
+Matrix
+spaceIntersection(
+    const Oriented_Image &p_left,
+    const Matrix &p_left_img,
+    const Oriented_Image &p_right,
+    const Matrix &p_right_img)
 {
     Matrix
-        isp_left = p_left_img,
-        isp_right = p_right_img;
+        isp_left = internal::undistortImage(p_left.interior(), p_left_img),
+        isp_right = internal::undistortImage(p_right.interior(), p_right_img);
 
     isp_left.conservativeResize(Eigen::NoChange, 3);
-    isp_left.col(2).fill(-p_left_meta.interior.f);
+    isp_left.col(2).fill(-p_left.interior().f);
     isp_right.conservativeResize(Eigen::NoChange, 3);
-    isp_right.col(2).fill(-p_right_meta.interior.f);
+    isp_right.col(2).fill(-p_right.interior().f);
 
     Matrix
-        aux_left = isp2aux(isp_left, p_left_meta.exterior),
-        aux_right = isp2aux(isp_right, p_right_meta.exterior);
-    double Xs1 = p_left_meta.exterior.x, Xs2 = p_right_meta.exterior.x,
-           Ys1 = p_left_meta.exterior.y, Ys2 = p_right_meta.exterior.y,
-           Zs1 = p_left_meta.exterior.z, Zs2 = p_right_meta.exterior.z;
+        aux_left = isp2aux(isp_left, p_left),
+        aux_right = isp2aux(isp_right, p_right);
+    double Xs1 = p_left.center().x(), Xs2 = p_right.center().x(),
+           Ys1 = p_left.center().y(), Ys2 = p_right.center().y(),
+           Zs1 = p_left.center().z(), Zs2 = p_right.center().z();
     double BX = Xs2 - Xs1,
            BY = Ys2 - Ys1,
            BZ = Zs2 - Zs1;
@@ -430,139 +975,400 @@ spaceIntersection(
     return result;
 }
 
-Space_Intersection_Ols_Result
-spaceIntersection(
-    std::span<const Space_Intersection_Ols_Block> p_list,
-    size_t p_max_loop,
-    double p_threshold,
-    Collinearity_Condition_Equation_Coefficient_Solver p_cce_solver,
-    Matrix_Inverse_Solver p_inverse_solver)
+namespace internal
 {
-    size_t count = p_list.size();
-    if (count < 2)
+    /**
+     * @brief oriented images of space intersection with image coordinates, lens distortion already removed. Both
+     * block types are turned into it so ols and batch solvers are shared.
+     *
+     */
+    struct Intersection_Input
+    {
+        std::vector<Oriented_Image> images;
+        /**
+         * @brief caller's image coordinates, or undistorted copies in `undistorted`
+         *
+         */
+        std::vector<const Matrix *> coordinates;
+        std::vector<Matrix> undistorted;
+    };
+
+    /**
+     * @brief replace observed coordinates of images with lens distortion by undistorted copies, and their interiors
+     * by ideal ones
+     *
+     */
+    void undistortInput(Intersection_Input &p_input)
+    {
+        // reserved so pointers into `undistorted` stay valid
+        p_input.undistorted.reserve(p_input.images.size());
+        for (size_t i = 0; i != p_input.images.size(); ++i)
+        {
+            const Oriented_Image &image = p_input.images[i];
+            if (image.interior().undistortion)
+            {
+                p_input.undistorted.push_back(undistortImage(image.interior(), *p_input.coordinates[i]));
+                p_input.coordinates[i] = &p_input.undistorted.back();
+                p_input.images[i] = Oriented_Image({image.exterior(), idealInterior(image.interior())});
+            }
+        }
+    }
+
+    Intersection_Input intersectionInput(std::span<const Space_Intersection_Ols_Block> p_list)
     {
-        throw std::invalid_argument("input param less than 2");
+        if (p_list.size() < 2)
+        {
+            throw std::invalid_argument("input param less than 2");
+        }
+
+        Intersection_Input input;
+        for (const Space_Intersection_Ols_Block &block : p_list)
+        {
+            input.images.emplace_back(block.meta);
+            input.coordinates.push_back(&block.image);
+        }
+        undistortInput(input);
+        return input;
     }
 
-    Space_Intersection_Ols_Result result{
-        .coordinate = spaceIntersection(
-            p_list[0].meta, p_list[0].image,
-            p_list[1].meta, p_list[1].image),
-        .info = Iterative_Algo_Info::NOT_CONVERGED};
-    Matrix &coordinate = result.coordinate;
+    Intersection_Input intersectionInput(std::span<const Space_Intersection_Oriented_Block> p_list)
+    {
+        if (p_list.size() < 2)
+        {
+            throw std::invalid_argument("input param less than 2");
+        }
+
+        Intersection_Input input;
+        for (const Space_Intersection_Oriented_Block &block : p_list)
+        {
+            input.images.push_back(block.oriented);
+            input.coordinates.push_back(&block.image);
+        }
+        undistortInput(input);
+        return input;
+    }
+
+    Space_Intersection_Ols_Result
+    spaceIntersection(
+        const Intersection_Input &p_input,
+        size_t p_max_loop,
+        double p_threshold,
+        Collinearity_Condition_Equation_Coefficient_Solver p_cce_solver,
+        Matrix_Inverse_Solver p_inverse_solver,
+        Iterative_Step_Option p_step)
+    {
+        const std::vector<Oriented_Image> &images = p_input.images;
+        const std::vector<const Matrix *> &coordinates = p_input.coordinates;
+        const size_t count = images.size();
+
+        Space_Intersection_Ols_Result result{
+            .coordinate = spaceIntersection(
+                images[0], *coordinates[0],
+                images[1], *coordinates[1]),
+            .info = Iterative_Algo_Info::NOT_CONVERGED};
+        Matrix &coordinate = result.coordinate;
 
 #if (M_libga_debug)
-    std::cout << "> coordinate init\n"
-              << coordinate.format(fmt::python)
-              << "\n";
+        std::cout << "> coordinate init\n"
+                  << coordinate.format(fmt::python)
+                  << "\n";
 #endif
 
-    while (p_max_loop-- > 0)
-    {
-        bool is_converged = true;
+        std::vector<Matrix> rotates;
+        for (const Oriented_Image &image : images)
+        {
+            rotates.push_back(image.rotate());
+        }
 
-        for (long int row = 0; row != coordinate.rows(); ++row)
+        std::vector<double> lambdas(coordinate.rows(), p_step.lambda);
+
+        while (p_max_loop-- > 0)
         {
+            bool is_converged = true;
+            double
+                ltl = 0.0,
+                correction_sq = 0.0;
+            ++result.iterations;
 
-            Matrix coeff(2 * count, 3), residual(2 * count, 1);
-            for (size_t i = 0uz; i != count; ++i)
+            for (long int row = 0; row != coordinate.rows(); ++row)
             {
-                const Image_Meta_Data &meta = p_list[i].meta;
-                const Matrix &img = p_list[i].image.row(i);
-                const Exterior &ex = meta.exterior;
-                const Interior &in = meta.interior;
 
-                const Matrix
-                    rotate = ex2yxzRotation(ex),
-                    &obj = coordinate.row(i),
-                    isp = aux2isp(obj2aux(obj, ex), rotate),
-                    img_calc = isp2img(isp, in);
+                Matrix coeff(2 * count, 3), residual(2 * count, 1);
+                for (size_t i = 0uz; i != count; ++i)
+                {
+                    const Matrix &img = coordinates[i]->row(row);
+                    const Exterior &ex = images[i].exterior();
+                    const Interior &in = images[i].interior();
+
+                    const Matrix
+                        &rotate = rotates[i],
+                        &obj = coordinate.row(row),
+                        isp = aux2isp(obj2aux(obj, ex), rotate),
+                        img_calc = isp2img(isp, in);
 #if (M_libga_debug)
-                std::cout
-                    << "> obj\n"
-                    << obj.format(fmt::python)
-                    << "\n"
-                    << "> img_calc\n"
-                    << img_calc.format(fmt::python)
-                    << "\n"
-                    << "> img\n"
-                    << img.format(fmt::python)
-                    << "\n";
+                    std::cout
+                        << "> obj\n"
+                        << obj.format(fmt::python)
+                        << "\n"
+                        << "> img_calc\n"
+                        << img_calc.format(fmt::python)
+                        << "\n"
+                        << "> img\n"
+                        << img.format(fmt::python)
+                        << "\n";
+#endif
+                    Matrix dxy = img - img_calc;
+                    Collinearity_Condition_Equation_Coefficient c =
+                        p_cce_solver({.x = img_calc(0, 0),
+                                      .y = img_calc(0, 1),
+                                      .f = in.f,
+                                      .h = in.f * in.m,
+                                      .kappa = ex.kappa,
+                                      .omega = ex.omega,
+                                      .z = isp(0, 2),
+                                      .rotate = rotate
+
+                        });
+
+                    Matrix l(dxy.rows() * 2, 1);
+                    for (auto li = 0; li != dxy.rows(); ++li)
+                    {
+                        l(2 * li) = dxy(li, 0);
+                        l(2 * li + 1) = dxy(li, 1);
+                    }
+
+#if (M_libga_debug)
+                    std::cout
+                        << "> l\n"
+                        << l.format(fmt::python)
+                        << "\n"
+                        << "> dxy\n"
+                        << dxy.format(fmt::python)
+                        << "\n";
 #endif
-                Matrix dxy = img - img_calc;
-                Collinearity_Condition_Equation_Coefficient c =
-                    p_cce_solver({.x = img_calc(0, 0),
-                                  .y = img_calc(0, 1),
-                                  .f = in.f,
-                                  .h = in.f * in.m,
-                                  .kappa = ex.kappa,
-                                  .omega = ex.omega,
-                                  .z = isp(0, 2),
-                                  .rotate = rotate
-
-                    });
-
-                Matrix l(dxy.rows() * 2, 1);
-                for (auto li = 0; li != dxy.rows(); ++li)
+
+                    coeff.block(2 * i, 0, 2, 3)
+                        << -c.toMatrix26().leftCols(3);
+                    residual.block(2 * i, 0, 2, 1) << l;
+                }
+
+                const Matrix
+                    normal = normalizedEquation(coeff),
+                    rhs = coeff.transpose() * residual;
+                const Normal_Equation_Solver solver(normal);
+                const double row_ltl = residual.squaredNorm();
+                auto cost_at = [&](const Matrix &p_dx)
+                {
+                    const Vector3 trial = coordinate.row(row).transpose() + p_dx;
+                    double sse = 0.0;
+                    for (size_t i = 0uz; i != count; ++i)
+                    {
+                        sse += (coordinates[i]->row(row).transpose() - images[i].obj2img(trial)).squaredNorm();
+                    }
+                    return sse;
+                };
+                Matrix correction;
+                bool accepted = true;
+                if (p_step.method == Iterative_Step_Method::LEVENBERG_MARQUARDT)
                 {
-                    l(2 * li) = dxy(li, 0);
-                    l(2 * li + 1) = dxy(li, 1);
+                    accepted = internal::dampedStep(normal, rhs, row_ltl, cost_at, lambdas[row], p_step, correction);
+                }
+                else
+                {
+                    correction = solver.solve(rhs);
+                }
+                ltl += row_ltl;
+                correction_sq += correction.squaredNorm();
+
+                if (!accepted)
+                {
+                    // a rejected step above threshold keeps the point where it is, it is tried again in next
+                    // iteration with the raised damping factor until `p_max_loop` runs out
+                    if (!(correction.cwiseAbs().maxCoeff() < p_threshold))
+                    {
+                        is_converged = false;
+                        continue;
+                    }
+                    correction.setZero();
                 }
 
 #if (M_libga_debug)
                 std::cout
-                    << "> l\n"
-                    << l.format(fmt::python)
+                    << "residual\n"
+                    << residual.format(fmt::python)
+                    << "\n"
+                    << "coeff\n"
+                    << coeff.format(fmt::python)
                     << "\n"
-                    << "> dxy\n"
-                    << dxy.format(fmt::python)
+                    << "correction\n"
+                    << correction.format(fmt::python)
                     << "\n";
 #endif
 
-                coeff.block(2 * i, 0, 2, 3)
-                    << -c.toMatrix26().leftCols(3);
-                residual.block(2 * i, 0, 2, 1) << l;
+                if (std::abs(correction(0, 0)) < p_threshold &&
+                    std::abs(correction(1, 0)) < p_threshold &&
+                    std::abs(correction(2, 0)) < p_threshold)
+                {
+                    result.rmse = rmse(coeff * correction - residual, count * 2, 3);
+                    const Matrix cofactor = p_inverse_solver
+                                                ? p_inverse_solver(coeff.transpose() * coeff)
+                                                : solver.cofactorBlock(0, 0, 3, 3);
+                    result.sigma = errorMatrix(result.rmse, cofactor);
+                    result.std_error = result.rmse * cofactor.diagonal().cwiseSqrt();
+                }
+                else
+                {
+                    is_converged = false;
+                }
+
+                coordinate(row, 0) += correction(0, 0);
+                coordinate(row, 1) += correction(1, 0);
+                coordinate(row, 2) += correction(2, 0);
             }
 
-            const Matrix correction = ols(coeff, residual);
+            result.telemetry.rmse.push_back(std::sqrt(ltl / ((2.0 * count - 3.0) * coordinate.rows())));
+            result.telemetry.correction_norm.push_back(std::sqrt(correction_sq));
+            result.telemetry.lambda.push_back(
+                p_step.method == Iterative_Step_Method::LEVENBERG_MARQUARDT
+                    ? *std::max_element(lambdas.begin(), lambdas.end())
+                    : 0.0);
 
-#if (M_libga_debug)
-            std::cout
-                << "residual\n"
-                << residual.format(fmt::python)
-                << "\n"
-                << "coeff\n"
-                << coeff.format(fmt::python)
-                << "\n"
-                << "correction\n"
-                << correction.format(fmt::python)
-                << "\n";
-#endif
-
-            if (std::abs(correction(0, 0)) < p_threshold &&
-                std::abs(correction(1, 0)) < p_threshold &&
-                std::abs(correction(2, 0)) < p_threshold)
+            if (is_converged)
             {
                 result.info = Iterative_Algo_Info::SUCCESS;
-                const Matrix N = p_inverse_solver(coeff.transpose() * coeff);
-                result.rmse = rmse(coeff * correction - residual, count * 2, 3);
-                result.sigma = errorMatrix(result.rmse, N);
+                break;
             }
-            else
+        }
+        return result;
+    }
+
+    Space_Intersection_Batch_Result
+    batchSpaceIntersection(
+        const Intersection_Input &p_input,
+        size_t p_max_loop,
+        double p_threshold,
+        Collinearity_Condition_Equation_Coefficient_Solver p_cce_solver)
+    {
+        const std::vector<Oriented_Image> &images = p_input.images;
+        const std::vector<const Matrix *> &coordinates = p_input.coordinates;
+        const size_t count = images.size();
+
+        const long int points = coordinates[0]->rows();
+        for (const Matrix *image : coordinates)
+        {
+            if (!(image->rows() == points && image->cols() == 2))
             {
-                is_converged = false;
+                matrixBadShape(image->rows(), image->cols(), points, 2);
             }
-
-            coordinate(row, 0) += correction(0, 0);
-            coordinate(row, 1) += correction(1, 0);
-            coordinate(row, 2) += correction(2, 0);
         }
-        if (is_converged)
+
+        std::vector<Matrix> rotates;
+        for (const Oriented_Image &image : images)
         {
-            break;
+            rotates.push_back(image.rotate());
         }
+
+        Space_Intersection_Batch_Result result{
+            .coordinate = spaceIntersection(
+                images[0], *coordinates[0],
+                images[1], *coordinates[1]),
+            .std_error = Matrix(points, 3),
+            .rmse = Vector(points),
+            .converged = std::vector<char>(points, 0)};
+
+        tbb::parallel_for(
+            tbb::blocked_range<long int>(0, points),
+            [&](const tbb::blocked_range<long int> &p_range)
+            {
+                for (long int row = p_range.begin(); row != p_range.end(); ++row)
+                {
+                    Vector3 obj = result.coordinate.row(row).transpose();
+                    const Point_Refinement refined = refinePoint(
+                        obj, count,
+                        [&](size_t i, const Vector3 &p_obj, Eigen::Matrix<double, 2, 3> &p_b, Vector2 &p_l)
+                        {
+                            const Exterior &ex = images[i].exterior();
+                            const Interior &in = images[i].interior();
+
+                            const Vector3 isp = images[i].obj2isp(p_obj);
+                            const Vector2 img_calc = isp2img3(isp, in);
+                            p_l << (*coordinates[i])(row, 0) - img_calc.x(),
+                                (*coordinates[i])(row, 1) - img_calc.y();
+                            const Collinearity_Condition_Equation_Coefficient c =
+                                p_cce_solver({.x = img_calc.x(),
+                                              .y = img_calc.y(),
+                                              .f = in.f,
+                                              .h = in.f * in.m,
+                                              .kappa = ex.kappa,
+                                              .omega = ex.omega,
+                                              .z = isp.z(),
+                                              .rotate = rotates[i]});
+                            p_b << -c.a11, -c.a12, -c.a13,
+                                -c.a21, -c.a22, -c.a23;
+                        },
+                        p_max_loop, p_threshold);
+
+                    result.coordinate.row(row) = obj.transpose();
+                    result.rmse(row) = refined.rmse;
+                    result.std_error.row(row) = refined.std_error.transpose();
+                    result.converged[row] = refined.converged;
+                }
+            });
+
+        result.info = std::all_of(result.converged.begin(), result.converged.end(), [](char p_c)
+                                  { return p_c != 0; })
+                          ? Iterative_Algo_Info::SUCCESS
+                          : Iterative_Algo_Info::NOT_CONVERGED;
+        return result;
     }
-    return result;
 }
 
-M_libga_end
\ No newline at end of file
+Space_Intersection_Ols_Result
+spaceIntersection(
+    std::span<const Space_Intersection_Ols_Block> p_list,
+    size_t p_max_loop,
+    double p_threshold,
+    Collinearity_Condition_Equation_Coefficient_Solver p_cce_solver,
+    Matrix_Inverse_Solver p_inverse_solver,
+    Iterative_Step_Option p_step)
+{
+    return internal::spaceIntersection(
+        internal::intersectionInput(p_list), p_max_loop, p_threshold, p_cce_solver, p_inverse_solver, p_step);
+}
+
+Space_Intersection_Ols_Result
+spaceIntersection(
+    std::span<const Space_Intersection_Oriented_Block> p_list,
+    size_t p_max_loop,
+    double p_threshold,
+    Collinearity_Condition_Equation_Coefficient_Solver p_cce_solver,
+    Matrix_Inverse_Solver p_inverse_solver,
+    Iterative_Step_Option p_step)
+{
+    return internal::spaceIntersection(
+        internal::intersectionInput(p_list), p_max_loop, p_threshold, p_cce_solver, p_inverse_solver, p_step);
+}
+
+Space_Intersection_Batch_Result
+batchSpaceIntersection(
+    std::span<const Space_Intersection_Ols_Block> p_list,
+    size_t p_max_loop,
+    double p_threshold,
+    Collinearity_Condition_Equation_Coefficient_Solver p_cce_solver)
+{
+    return internal::batchSpaceIntersection(
+        internal::intersectionInput(p_list), p_max_loop, p_threshold, p_cce_solver);
+}
+
+Space_Intersection_Batch_Result
+batchSpaceIntersection(
+    std::span<const Space_Intersection_Oriented_Block> p_list,
+    size_t p_max_loop,
+    double p_threshold,
+    Collinearity_Condition_Equation_Coefficient_Solver p_cce_solver)
+{
+    return internal::batchSpaceIntersection(
+        internal::intersectionInput(p_list), p_max_loop, p_threshold, p_cce_solver);
+}
+
+M_libga_end
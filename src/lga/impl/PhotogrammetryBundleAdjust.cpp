@@ -0,0 +1,446 @@
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+
+#include <lga/Photogrammetry>
+
+M_libga_begin
+
+namespace internal
+{
+    /**
+     * @brief collinearity condition equation of one observation linearized at current exterior and point
+     *
+     */
+    struct Bundle_Linearization
+    {
+        Eigen::Matrix<double, 2, 6> a;
+        Eigen::Matrix<double, 2, 3> b;
+        Vector2 l;
+    };
+
+    /**
+     * @brief observations grouped by point, and slots of reduced camera system each pair `(a, b)` with `a >= b` of
+     * observations of a point writes to, `k * (k + 1) / 2` entries for a point observed `k` times. One dense block is
+     * kept per distinct image pair. Structure doesn't change between iterations so it is built once.
+     *
+     */
+    struct Bundle_Structure
+    {
+        std::vector<size_t>
+            point_offset,
+            point_obs,
+            pair_offset,
+            pair_slot;
+        /**
+         * @brief (row image, col image) of each block with row >= col, first blocks are diagonal of each image
+         *
+         */
+        std::vector<std::pair<size_t, size_t>> slot_block;
+        std::vector<char> is_control;
+        size_t free_points = 0;
+    };
+
+    Bundle_Structure
+    makeBundleStructure(
+        size_t p_images,
+        size_t p_points,
+        std::span<const Bundle_Observation> p_observations,
+        std::span<const size_t> p_controls)
+    {
+        Bundle_Structure st;
+        st.is_control.assign(p_points, 0);
+        for (size_t ci : p_controls)
+        {
+            if (ci >= p_points)
+            {
+                throw std::invalid_argument(std::format("control point `{:d}` out of range", ci));
+            }
+            st.is_control[ci] = 1;
+        }
+
+        st.point_offset.assign(p_points + 1, 0);
+        for (size_t oi = 0; oi != p_observations.size(); ++oi)
+        {
+            const Bundle_Observation &o = p_observations[oi];
+            if (o.image >= p_images || o.point >= p_points)
+            {
+                throw std::invalid_argument(
+                    std::format("observation `{:d}` refers to image `{:d}` and point `{:d}` out of range", oi, o.image, o.point));
+            }
+            ++st.point_offset[o.point + 1];
+        }
+        for (size_t pi = 0; pi != p_points; ++pi)
+        {
+            st.point_offset[pi + 1] += st.point_offset[pi];
+        }
+
+        st.point_obs.resize(p_observations.size());
+        std::vector<size_t> cursor(st.point_offset.begin(), st.point_offset.end() - 1);
+        for (size_t oi = 0; oi != p_observations.size(); ++oi)
+        {
+            st.point_obs[cursor[p_observations[oi].point]++] = oi;
+        }
+
+        std::unordered_map<size_t, size_t> slot_of;
+        for (size_t ii = 0; ii != p_images; ++ii)
+        {
+            slot_of.emplace(ii * p_images + ii, ii);
+            st.slot_block.emplace_back(ii, ii);
+        }
+
+        st.pair_offset.assign(p_points + 1, 0);
+        for (size_t pi = 0; pi != p_points; ++pi)
+        {
+            st.pair_offset[pi] = st.pair_slot.size();
+            if (st.is_control[pi])
+            {
+                continue;
+            }
+
+            const size_t beg = st.point_offset[pi], end = st.point_offset[pi + 1];
+            if (end - beg < 2)
+            {
+                throw std::invalid_argument(
+                    std::format("point `{:d}` is observed `{:d}` times, at least 2 required", pi, end - beg));
+            }
+            ++st.free_points;
+
+            for (size_t a = beg; a != end; ++a)
+            {
+                for (size_t b = beg; b <= a; ++b)
+                {
+                    const size_t
+                        ia = p_observations[st.point_obs[a]].image,
+                        ib = p_observations[st.point_obs[b]].image,
+                        r = std::max(ia, ib),
+                        c = std::min(ia, ib);
+                    auto [it, inserted] = slot_of.emplace(r * p_images + c, st.slot_block.size());
+                    if (inserted)
+                    {
+                        st.slot_block.emplace_back(r, c);
+                    }
+                    st.pair_slot.push_back(it->second);
+                }
+            }
+        }
+        st.pair_offset[p_points] = st.pair_slot.size();
+
+        return st;
+    }
+
+    Bundle_Linearization
+    bundleLinearize(
+        const Bundle_Observation &p_obs,
+        const Interior &p_in,
+        const Exterior &p_ex,
+        const Matrix3 &p_rotate3,
+        const Matrix &p_rotate,
+        const Vector3 &p_point,
+        const Collinearity_Condition_Equation_Coefficient_Solver &p_cce_solver)
+    {
+        const Vector3 isp = obj2isp3(p_point, p_ex, p_rotate3);
+        const Vector2 img_calc = isp2img3(isp, p_in);
+        const Collinearity_Condition_Equation_Coefficient c = p_cce_solver(
+            {.x = img_calc.x(),
+             .y = img_calc.y(),
+             .f = p_in.f,
+             .h = p_in.f * p_in.m,
+             .kappa = p_ex.kappa,
+             .omega = p_ex.omega,
+             .z = isp.z(),
+             .rotate = p_rotate});
+
+        Bundle_Linearization lin;
+        lin.a.row(0) = c.row1();
+        lin.a.row(1) = c.row2();
+        lin.b = -lin.a.leftCols<3>();
+        lin.l << p_obs.x - img_calc.x(), p_obs.y - img_calc.y();
+        return lin;
+    }
+
+    /**
+     * @brief per thread part of reduced camera system and scratch of point elimination, summed after the pass
+     *
+     */
+    struct Bundle_Accumulator
+    {
+        std::vector<Matrix6> blocks;
+        Vector ea;
+        std::vector<Eigen::Matrix<double, 6, 3>> w, wv;
+    };
+}
+
+Bundle_Adjustment_Result
+bundleAdjust(
+    std::span<const Image_Meta_Data> p_images,
+    const Matrix &p_points,
+    std::span<const Bundle_Observation> p_observations,
+    std::span<const size_t> p_controls,
+    size_t p_max_loop,
+    double p_threshold,
+    Collinearity_Condition_Equation_Coefficient_Solver p_cce_solver)
+{
+    internal::validateCoordinateMatrix(p_points);
+
+    if (std::any_of(p_images.begin(), p_images.end(), [](const Image_Meta_Data &p_meta)
+                    { return p_meta.interior.undistortion != nullptr; }))
+    {
+        std::vector<Image_Meta_Data> images(p_images.begin(), p_images.end());
+        std::vector<Bundle_Observation> observations(p_observations.begin(), p_observations.end());
+        for (Bundle_Observation &o : observations)
+        {
+            // image index is validated with the structure below, an invalid one is left for it to report
+            if (o.image < images.size() && images[o.image].interior.undistortion)
+            {
+                const Vector2 img = images[o.image].interior.undistortion->undistort3(Vector2(o.x, o.y));
+                o.x = img.x();
+                o.y = img.y();
+            }
+        }
+        for (Image_Meta_Data &meta : images)
+        {
+            meta.interior = internal::idealInterior(meta.interior);
+        }
+        return bundleAdjust(images, p_points, observations, p_controls, p_max_loop, p_threshold, p_cce_solver);
+    }
+
+    const size_t
+        n_img = p_images.size(),
+        n_pts = p_points.rows(),
+        n_obs = p_observations.size();
+
+    const internal::Bundle_Structure st = internal::makeBundleStructure(n_img, n_pts, p_observations, p_controls);
+
+    const size_t
+        n = 2 * n_obs,
+        t = 6 * n_img + 3 * st.free_points;
+    if (!(n > t))
+    {
+        throw std::invalid_argument(
+            std::format("`{:d}` observations are not enough for `{:d}` unknowns", n, t));
+    }
+
+    Bundle_Adjustment_Result result{
+        .points = p_points,
+        .info = Iterative_Algo_Info::NOT_CONVERGED};
+    std::vector<Exterior> &exteriors = result.exteriors;
+    Matrix &points = result.points;
+    for (const Image_Meta_Data &meta : p_images)
+    {
+        exteriors.push_back(meta.exterior);
+    }
+
+    std::vector<Matrix3> rotates3(n_img);
+    std::vector<Matrix> rotates(n_img, Matrix(3, 3));
+    std::vector<Matrix6> blocks(st.slot_block.size());
+    // linearization of each observation in order of `point_obs`, reused by back substitution and residuals
+    std::vector<internal::Bundle_Linearization> lins(n_obs);
+    std::vector<Matrix3> normals(n_pts);
+    std::vector<Vector3> rhss(n_pts);
+    tbb::enumerable_thread_specific<internal::Bundle_Accumulator> accumulators(
+        internal::Bundle_Accumulator{
+            .blocks = std::vector<Matrix6>(st.slot_block.size(), Matrix6::Zero()),
+            .ea = Vector::Zero(6 * n_img)});
+    std::vector<Sparse_Triplet> triplets;
+    triplets.reserve(st.slot_block.size() * 36);
+
+    Vector ea(6 * n_img);
+    Matrix dp(n_pts, 3);
+    Sparse_Matrix reduced(6 * n_img, 6 * n_img);
+    Sparse_Cholesky ldlt;
+
+    while (p_max_loop-- > 0)
+    {
+        ++result.iterations;
+        for (size_t ii = 0; ii != n_img; ++ii)
+        {
+            rotates3[ii] = ex2yxzRotation3(exteriors[ii]);
+            rotates[ii] = rotates3[ii];
+        }
+
+        for (internal::Bundle_Accumulator &acc : accumulators)
+        {
+            for (Matrix6 &blk : acc.blocks)
+            {
+                blk.setZero();
+            }
+            acc.ea.setZero();
+        }
+
+        tbb::parallel_for(
+            tbb::blocked_range<size_t>(0, n_pts),
+            [&](const tbb::blocked_range<size_t> &p_range)
+            {
+                internal::Bundle_Accumulator &acc = accumulators.local();
+                for (size_t pi = p_range.begin(); pi != p_range.end(); ++pi)
+                {
+                    const size_t beg = st.point_offset[pi], end = st.point_offset[pi + 1];
+
+                    Matrix3 &V = normals[pi];
+                    Vector3 &eb = rhss[pi];
+                    V.setZero();
+                    eb.setZero();
+                    for (size_t k = beg; k != end; ++k)
+                    {
+                        const Bundle_Observation &o = p_observations[st.point_obs[k]];
+                        const internal::Bundle_Linearization &lin = lins[k] = internal::bundleLinearize(
+                            o, p_images[o.image].interior, exteriors[o.image],
+                            rotates3[o.image], rotates[o.image],
+                            points.row(o.point).transpose(), p_cce_solver);
+                        acc.blocks[o.image].noalias() += lin.a.transpose() * lin.a;
+                        acc.ea.segment<6>(6 * o.image).noalias() += lin.a.transpose() * lin.l;
+                        V.noalias() += lin.b.transpose() * lin.b;
+                        eb.noalias() += lin.b.transpose() * lin.l;
+                    }
+
+                    if (st.is_control[pi])
+                    {
+                        continue;
+                    }
+
+                    // eliminate point: N_cc -= W * V^-1 * W.T, u_c -= W * V^-1 * u_p
+                    const Matrix3 V_inv = V.inverse();
+                    const size_t m = end - beg;
+                    acc.w.resize(m);
+                    acc.wv.resize(m);
+                    for (size_t a = 0; a != m; ++a)
+                    {
+                        acc.w[a].noalias() = lins[beg + a].a.transpose() * lins[beg + a].b;
+                        acc.wv[a].noalias() = acc.w[a] * V_inv;
+                        const size_t ia = p_observations[st.point_obs[beg + a]].image;
+                        acc.ea.segment<6>(6 * ia).noalias() -= acc.wv[a] * eb;
+                    }
+
+                    // block (ia, ib) gets `wv[a] * w[b].T`, its transpose `wv[b] * w[a].T` when stored as (ib, ia)
+                    const size_t *slot = st.pair_slot.data() + st.pair_offset[pi];
+                    for (size_t a = 0; a != m; ++a)
+                    {
+                        const size_t ia = p_observations[st.point_obs[beg + a]].image;
+                        for (size_t b = 0; b <= a; ++b, ++slot)
+                        {
+                            const size_t ib = p_observations[st.point_obs[beg + b]].image;
+                            Matrix6 &blk = acc.blocks[*slot];
+                            if (ia >= ib)
+                            {
+                                blk.noalias() -= acc.wv[a] * acc.w[b].transpose();
+                            }
+                            if (ia <= ib && a != b)
+                            {
+                                blk.noalias() -= acc.wv[b] * acc.w[a].transpose();
+                            }
+                        }
+                    }
+                }
+            });
+
+        for (Matrix6 &blk : blocks)
+        {
+            blk.setZero();
+        }
+        ea.setZero();
+        for (const internal::Bundle_Accumulator &acc : accumulators)
+        {
+            for (size_t si = 0; si != blocks.size(); ++si)
+            {
+                blocks[si] += acc.blocks[si];
+            }
+            ea += acc.ea;
+        }
+
+        triplets.clear();
+        for (size_t si = 0; si != blocks.size(); ++si)
+        {
+            const auto [r, c] = st.slot_block[si];
+            for (int bc = 0; bc != 6; ++bc)
+            {
+                for (int br = (r == c ? bc : 0); br != 6; ++br)
+                {
+                    triplets.emplace_back(6 * r + br, 6 * c + bc, blocks[si](br, bc));
+                }
+            }
+        }
+        reduced.setFromTriplets(triplets.begin(), triplets.end());
+
+        if (result.iterations == 1)
+        {
+            ldlt.analyzePattern(reduced);
+        }
+        ldlt.factorize(reduced);
+        if (ldlt.info() != Eigen::Success)
+        {
+            throw std::invalid_argument("reduced camera system is singular");
+        }
+
+        const Vector dc = ldlt.solve(ea);
+
+        // back substitute points: dp = V^-1 * (u_p - W.T * dc)
+        tbb::parallel_for(
+            tbb::blocked_range<size_t>(0, n_pts),
+            [&](const tbb::blocked_range<size_t> &p_range)
+            {
+                for (size_t pi = p_range.begin(); pi != p_range.end(); ++pi)
+                {
+                    if (st.is_control[pi])
+                    {
+                        dp.row(pi).setZero();
+                        continue;
+                    }
+
+                    Vector3 rhs = rhss[pi];
+                    for (size_t k = st.point_offset[pi]; k != st.point_offset[pi + 1]; ++k)
+                    {
+                        const size_t ii = p_observations[st.point_obs[k]].image;
+                        const internal::Bundle_Linearization &lin = lins[k];
+                        rhs.noalias() -= lin.b.transpose() * (lin.a * dc.segment<6>(6 * ii));
+                    }
+                    dp.row(pi) = normals[pi].ldlt().solve(rhs).transpose();
+                }
+            });
+
+        bool is_converged = true;
+        for (size_t ii = 0; ii != n_img && is_converged; ++ii)
+        {
+            is_converged = std::abs(dc(6 * ii + 3)) < p_threshold &&
+                           std::abs(dc(6 * ii + 4)) < p_threshold &&
+                           std::abs(dc(6 * ii + 5)) < p_threshold;
+        }
+
+        if (is_converged)
+        {
+            Matrix v(n, 1);
+            for (size_t k = 0; k != n_obs; ++k)
+            {
+                const size_t oi = st.point_obs[k];
+                const Bundle_Observation &o = p_observations[oi];
+                const internal::Bundle_Linearization &lin = lins[k];
+                v.middleRows<2>(2 * oi) =
+                    lin.a * dc.segment<6>(6 * o.image) + lin.b * dp.row(o.point).transpose() - lin.l;
+            }
+            result.rmse = rmse(v, n, t);
+            result.std_error = errorMatrix(result.rmse, cofactorDiagonal(ldlt));
+            result.info = Iterative_Algo_Info::SUCCESS;
+            break;
+        }
+
+        for (size_t ii = 0; ii != n_img; ++ii)
+        {
+            Exterior &ex = exteriors[ii];
+            ex.x += dc(6 * ii);
+            ex.y += dc(6 * ii + 1);
+            ex.z += dc(6 * ii + 2);
+            ex.phi += dc(6 * ii + 3);
+            ex.omega += dc(6 * ii + 4);
+            ex.kappa += dc(6 * ii + 5);
+        }
+        points += dp;
+    }
+
+    return result;
+}
+
+M_libga_end
@@ -0,0 +1,224 @@
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+
+#include <lga/Photogrammetry>
+
+M_libga_begin
+
+namespace internal
+{
+    /**
+     * @brief rows of a chunk handled by one task in `distort` and `Undistortion_Grid::undistort`
+     *
+     */
+    constexpr size_t distortion_batch_grain = 8192;
+
+    /**
+     * @brief inverse of lens distortion by fixed point iteration `x = x_d - d(x)`, only used while building grid
+     *
+     */
+    Vector2 undistortIterative(const Vector2 &p_img, const Lens_Distortion &p_distortion) noexcept
+    {
+        Vector2 img = p_img;
+        for (int it = 0; it != 50; ++it)
+        {
+            const Vector2 next = p_img - (distort3(img, p_distortion) - img);
+            const double change = (next - img).squaredNorm();
+            img = next;
+            if (change <= 1e-30 * (1.0 + p_img.squaredNorm()))
+            {
+                break;
+            }
+        }
+        return img;
+    }
+
+    /**
+     * @brief run `p_func(row)` over `[0, p_rows)`, in parallel chunks if there are many rows
+     *
+     */
+    template <typename Func>
+    void forEachRow(long int p_rows, Func &&p_func)
+    {
+        if (p_rows <= static_cast<long int>(distortion_batch_grain))
+        {
+            for (long int r = 0; r != p_rows; ++r)
+            {
+                p_func(r);
+            }
+            return;
+        }
+        tbb::parallel_for(
+            tbb::blocked_range<long int>(0, p_rows, distortion_batch_grain),
+            [&](const tbb::blocked_range<long int> &p_range)
+            {
+                for (long int r = p_range.begin(); r != p_range.end(); ++r)
+                {
+                    p_func(r);
+                }
+            });
+    }
+
+    Interior idealInterior(const Interior &p_in) noexcept
+    {
+        Interior in = p_in;
+        in.undistortion.reset();
+        return in;
+    }
+
+    Matrix undistortImage(const Interior &p_in, const Matrix &p_img)
+    {
+        return p_in.undistortion ? p_in.undistortion->undistort(p_img) : p_img;
+    }
+}
+
+bool Lens_Distortion::isZero() const noexcept
+{
+    return k1 == 0.0 && k2 == 0.0 && k3 == 0.0 && p1 == 0.0 && p2 == 0.0;
+}
+
+Vector2 distort3(const Vector2 &p_img, const Lens_Distortion &p_distortion) noexcept
+{
+    const double
+        x = p_img.x(),
+        y = p_img.y(),
+        xx = x * x,
+        yy = y * y,
+        xy = x * y,
+        r2 = xx + yy,
+        radial = r2 * (p_distortion.k1 + r2 * (p_distortion.k2 + r2 * p_distortion.k3));
+    return Vector2(
+        x + x * radial + p_distortion.p1 * (r2 + 2 * xx) + 2 * p_distortion.p2 * xy,
+        y + y * radial + p_distortion.p2 * (r2 + 2 * yy) + 2 * p_distortion.p1 * xy);
+}
+
+Matrix distort(const Matrix &p_img, const Lens_Distortion &p_distortion)
+{
+    if (p_img.cols() != 2)
+    {
+        matrixBadShape(p_img.rows(), p_img.cols(), p_img.rows(), 2);
+    }
+
+    Matrix out(p_img.rows(), 2);
+    internal::forEachRow(
+        p_img.rows(),
+        [&](long int r)
+        {
+            out.row(r) = distort3(p_img.row(r).transpose(), p_distortion).transpose();
+        });
+    return out;
+}
+
+Undistortion_Grid::Undistortion_Grid(
+    const Lens_Distortion &p_distortion,
+    double p_half_width,
+    double p_half_height,
+    size_t p_cols,
+    size_t p_rows)
+    : m_distortion(p_distortion),
+      m_half_width(p_half_width),
+      m_half_height(p_half_height),
+      m_step_x(0.0),
+      m_step_y(0.0),
+      m_max_error(0.0),
+      m_cols(p_cols),
+      m_rows(p_rows)
+{
+    if (!(p_half_width > 0.0 && p_half_height > 0.0 && p_cols > 0 && p_rows > 0))
+    {
+        throw std::invalid_argument(
+            std::format(
+                "invalid undistortion grid: half width {}, half height {}, {:d} cols, {:d} rows",
+                p_half_width, p_half_height, p_cols, p_rows));
+    }
+
+    m_step_x = 2 * m_half_width / m_cols;
+    m_step_y = 2 * m_half_height / m_rows;
+    const size_t stride = m_cols + 1;
+    m_dx.resize(stride * (m_rows + 1));
+    m_dy.resize(stride * (m_rows + 1));
+
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, m_rows + 1),
+        [&](const tbb::blocked_range<size_t> &p_range)
+        {
+            for (size_t r = p_range.begin(); r != p_range.end(); ++r)
+            {
+                for (size_t c = 0; c != stride; ++c)
+                {
+                    const Vector2 node(-m_half_width + c * m_step_x, -m_half_height + r * m_step_y);
+                    const Vector2 d = internal::undistortIterative(node, p_distortion) - node;
+                    m_dx[r * stride + c] = d.x();
+                    m_dy[r * stride + c] = d.y();
+                }
+            }
+        });
+
+    for (size_t r = 0; r != m_rows; ++r)
+    {
+        for (size_t c = 0; c != m_cols; ++c)
+        {
+            const Vector2 center(-m_half_width + (c + 0.5) * m_step_x, -m_half_height + (r + 0.5) * m_step_y);
+            m_max_error = std::max(
+                m_max_error,
+                (undistort3(center) - internal::undistortIterative(center, p_distortion)).norm());
+        }
+    }
+}
+
+Vector2 Undistortion_Grid::undistort3(const Vector2 &p_img) const noexcept
+{
+    const double
+        gx = (p_img.x() + m_half_width) / m_step_x,
+        gy = (p_img.y() + m_half_height) / m_step_y;
+    // clamp cell, not weights, so outside points are extrapolated linearly
+    const size_t
+        c = static_cast<size_t>(std::clamp(std::floor(gx), 0.0, static_cast<double>(m_cols - 1))),
+        r = static_cast<size_t>(std::clamp(std::floor(gy), 0.0, static_cast<double>(m_rows - 1))),
+        stride = m_cols + 1,
+        i00 = r * stride + c,
+        i10 = i00 + stride;
+    const double
+        tx = gx - c,
+        ty = gy - r,
+        w00 = (1 - tx) * (1 - ty),
+        w01 = tx * (1 - ty),
+        w10 = (1 - tx) * ty,
+        w11 = tx * ty;
+    return Vector2(
+        p_img.x() + w00 * m_dx[i00] + w01 * m_dx[i00 + 1] + w10 * m_dx[i10] + w11 * m_dx[i10 + 1],
+        p_img.y() + w00 * m_dy[i00] + w01 * m_dy[i00 + 1] + w10 * m_dy[i10] + w11 * m_dy[i10 + 1]);
+}
+
+Matrix Undistortion_Grid::undistort(const Matrix &p_img) const
+{
+    if (p_img.cols() != 2)
+    {
+        matrixBadShape(p_img.rows(), p_img.cols(), p_img.rows(), 2);
+    }
+
+    Matrix out(p_img.rows(), 2);
+    internal::forEachRow(
+        p_img.rows(),
+        [&](long int r)
+        {
+            out.row(r) = undistort3(p_img.row(r).transpose()).transpose();
+        });
+    return out;
+}
+
+double Undistortion_Grid::maxError() const noexcept
+{
+    return m_max_error;
+}
+
+const Lens_Distortion &Undistortion_Grid::distortion() const noexcept
+{
+    return m_distortion;
+}
+
+M_libga_end
@@ -0,0 +1,316 @@
+#include <cmath>
+#include <vector>
+#include <limits>
+#include <array>
+#include <complex>
+#include <utility>
+
+#include <lga/Photogrammetry>
+
+M_libga_begin
+
+namespace internal
+{
+    /**
+     * @brief real roots of polynomial `c[0] + c[1] * x + ... + c[n] * x^n`, eigenvalues of companion matrix polished
+     * by newton iterations
+     *
+     */
+    std::vector<double> polynomialRealRoots(std::span<const double> p_coeff)
+    {
+        size_t degree = p_coeff.size() - 1;
+        double scale = 0.0;
+        for (double c : p_coeff)
+        {
+            scale = std::max(scale, std::abs(c));
+        }
+        while (degree > 0 && std::abs(p_coeff[degree]) <= 1e-12 * scale)
+        {
+            --degree;
+        }
+        if (degree == 0)
+        {
+            return {};
+        }
+
+        Matrix companion = Matrix::Zero(degree, degree);
+        for (size_t i = 0; i != degree; ++i)
+        {
+            companion(0, i) = -p_coeff[degree - 1 - i] / p_coeff[degree];
+        }
+        for (size_t i = 1; i != degree; ++i)
+        {
+            companion(i, i - 1) = 1.0;
+        }
+
+        std::vector<double> roots;
+        const Eigen::EigenSolver<Matrix> es(companion, false);
+        for (const std::complex<double> &ev : es.eigenvalues())
+        {
+            if (std::abs(ev.imag()) > 1e-6 * (1.0 + std::abs(ev.real())))
+            {
+                continue;
+            }
+            double x = ev.real();
+            for (int it = 0; it != 3; ++it)
+            {
+                double p = 0.0, dp = 0.0;
+                for (size_t k = degree + 1; k-- > 0;)
+                {
+                    dp = dp * x + p;
+                    p = p * x + p_coeff[k];
+                }
+                if (dp == 0.0)
+                {
+                    break;
+                }
+                x -= p / dp;
+            }
+            roots.push_back(x);
+        }
+        return roots;
+    }
+
+    /**
+     * @brief unit direction of image point in image space coordinate system
+     *
+     */
+    Vector3 imageBearing(double p_x, double p_y, const Interior &p_in) noexcept
+    {
+        return Vector3(p_x, p_y, -p_in.f).normalized();
+    }
+
+    /**
+     * @brief rotation and center which maps image space coordinates `p_isp` onto object coordinates `p_obj`, i.e.
+     * `obj = rotate * isp + center`
+     *
+     */
+    std::pair<Matrix3, Vector3>
+    absoluteOrientation(const std::array<Vector3, 3> &p_isp, const std::array<Vector3, 3> &p_obj)
+    {
+        const Vector3
+            isp_mean = (p_isp[0] + p_isp[1] + p_isp[2]) / 3.0,
+            obj_mean = (p_obj[0] + p_obj[1] + p_obj[2]) / 3.0;
+        Matrix3 h = Matrix3::Zero();
+        for (int i = 0; i != 3; ++i)
+        {
+            h.noalias() += (p_isp[i] - isp_mean) * (p_obj[i] - obj_mean).transpose();
+        }
+
+        const Eigen::JacobiSVD<Matrix3> svd(h, Eigen::ComputeFullU | Eigen::ComputeFullV);
+        Matrix3 d = Matrix3::Identity();
+        d(2, 2) = (svd.matrixV() * svd.matrixU().transpose()).determinant() < 0 ? -1.0 : 1.0;
+        const Matrix3 rotate = svd.matrixV() * d * svd.matrixU().transpose();
+        return {rotate, obj_mean - rotate * isp_mean};
+    }
+
+    /**
+     * @brief candidates of perspective-3-point problem, grunert's solution
+     *
+     */
+    std::vector<std::pair<Matrix3, Vector3>>
+    p3pCandidates(const std::array<Vector3, 3> &p_bearing, const std::array<Vector3, 3> &p_obj)
+    {
+        const double
+            a2 = (p_obj[1] - p_obj[2]).squaredNorm(),
+            b2 = (p_obj[0] - p_obj[2]).squaredNorm(),
+            c2 = (p_obj[0] - p_obj[1]).squaredNorm(),
+            cos_a = p_bearing[1].dot(p_bearing[2]),
+            cos_b = p_bearing[0].dot(p_bearing[2]),
+            cos_g = p_bearing[0].dot(p_bearing[1]);
+
+        std::vector<std::pair<Matrix3, Vector3>> candidates;
+        if (b2 == 0.0)
+        {
+            return candidates;
+        }
+
+        const double
+            amc = (a2 - c2) / b2,
+            apc = (a2 + c2) / b2,
+            bmc = (b2 - c2) / b2,
+            bma = (b2 - a2) / b2;
+
+        const double coeff[5]{
+            (1 + amc) * (1 + amc) - 4 * a2 / b2 * cos_g * cos_g,
+            4 * (-amc * (1 + amc) * cos_b + 2 * a2 / b2 * cos_g * cos_g * cos_b - (1 - apc) * cos_a * cos_g),
+            2 * (amc * amc - 1 + 2 * amc * amc * cos_b * cos_b + 2 * bmc * cos_a * cos_a -
+                 4 * apc * cos_a * cos_b * cos_g + 2 * bma * cos_g * cos_g),
+            4 * (amc * (1 - amc) * cos_b - (1 - apc) * cos_a * cos_g + 2 * c2 / b2 * cos_a * cos_a * cos_b),
+            (amc - 1) * (amc - 1) - 4 * c2 / b2 * cos_a * cos_a};
+
+        for (double v : polynomialRealRoots(coeff))
+        {
+            const double
+                den = 2 * (cos_g - v * cos_a),
+                s1_2 = b2 / (1 + v * v - 2 * v * cos_b);
+            if (den == 0.0 || !(s1_2 > 0.0) || v <= 0.0)
+            {
+                continue;
+            }
+            const double u = ((-1 + amc) * v * v - 2 * amc * cos_b * v + 1 + amc) / den;
+            if (u <= 0.0)
+            {
+                continue;
+            }
+
+            const double s1 = std::sqrt(s1_2);
+            candidates.push_back(absoluteOrientation(
+                {s1 * p_bearing[0], u * s1 * p_bearing[1], v * s1 * p_bearing[2]},
+                p_obj));
+        }
+        return candidates;
+    }
+
+    double reprojectionError(
+        const Interior &p_in, const Matrix &p_img, const Matrix &p_obj, const Exterior &p_ex) noexcept
+    {
+        const Matrix3 rotate = ex2yxzRotation3(p_ex);
+        double sse = 0.0;
+        for (long int pi = 0; pi != p_obj.rows(); ++pi)
+        {
+            const Vector3 isp = obj2isp3(p_obj.row(pi).transpose(), p_ex, rotate);
+            if (!(isp.z() < 0.0))
+            {
+                return std::numeric_limits<double>::infinity();
+            }
+            sse += (isp2img3(isp, p_in) - p_img.row(pi).transpose()).squaredNorm();
+        }
+        return sse;
+    }
+}
+
+Exterior centroidExterior(const Interior &p_in, [[maybe_unused]] const Matrix &p_img, const Matrix &p_obj)
+{
+    return Exterior::makeFrom(p_in, p_obj);
+}
+
+Exterior p3pExterior(const Interior &p_in, const Matrix &p_img, const Matrix &p_obj)
+{
+    if (p_in.undistortion)
+    {
+        return p3pExterior(internal::idealInterior(p_in), internal::undistortImage(p_in, p_img), p_obj);
+    }
+
+    const long int n = p_img.rows();
+    if (n < 3)
+    {
+        return centroidExterior(p_in, p_img, p_obj);
+    }
+
+    // well spread triple in image: farthest from centroid, farthest from it, then largest triangle
+    const Vector2 mean = p_img.colwise().mean().transpose();
+    long int i0 = 0, i1 = 0, i2 = 0;
+    (p_img.rowwise() - mean.transpose()).rowwise().squaredNorm().maxCoeff(&i0);
+    (p_img.rowwise() - p_img.row(i0)).rowwise().squaredNorm().maxCoeff(&i1);
+    const Vector2 e = (p_img.row(i1) - p_img.row(i0)).transpose();
+    double area = -1.0;
+    for (long int pi = 0; pi != n; ++pi)
+    {
+        const Vector2 d = (p_img.row(pi) - p_img.row(i0)).transpose();
+        const double a = std::abs(e.x() * d.y() - e.y() * d.x());
+        if (a > area)
+        {
+            area = a;
+            i2 = pi;
+        }
+    }
+
+    const std::array<Vector3, 3>
+        bearing{
+            internal::imageBearing(p_img(i0, 0), p_img(i0, 1), p_in),
+            internal::imageBearing(p_img(i1, 0), p_img(i1, 1), p_in),
+            internal::imageBearing(p_img(i2, 0), p_img(i2, 1), p_in)},
+        obj{
+            p_obj.row(i0).transpose(),
+            p_obj.row(i1).transpose(),
+            p_obj.row(i2).transpose()};
+
+    Exterior best = centroidExterior(p_in, p_img, p_obj);
+    double best_error = std::numeric_limits<double>::infinity();
+    for (const auto &[rotate, center] : internal::p3pCandidates(bearing, obj))
+    {
+        const Exterior ex = Exterior::makeFrom(center, rotate);
+        const double error = internal::reprojectionError(p_in, p_img, p_obj, ex);
+        if (error < best_error)
+        {
+            best_error = error;
+            best = ex;
+        }
+    }
+    return best;
+}
+
+Exterior dltExterior(const Interior &p_in, const Matrix &p_img, const Matrix &p_obj)
+{
+    if (p_in.undistortion)
+    {
+        return dltExterior(internal::idealInterior(p_in), internal::undistortImage(p_in, p_img), p_obj);
+    }
+
+    const long int n = p_img.rows();
+    if (n < 6)
+    {
+        throw std::invalid_argument(
+            std::format("`{:d}` points are not enough for direct linear transformation", n));
+    }
+
+    const Vector3 obj_mean = p_obj.colwise().mean().transpose();
+    const Vector2 img_mean = p_img.colwise().mean().transpose();
+    const Matrix obj_centered = p_obj.rowwise() - obj_mean.transpose();
+
+    const Eigen::JacobiSVD<Matrix> planarity(obj_centered);
+    if (planarity.singularValues()(2) < 1e-3 * planarity.singularValues()(0))
+    {
+        return p3pExterior(p_in, p_img, p_obj);
+    }
+
+    const double
+        obj_scale = std::sqrt(3.0) / obj_centered.rowwise().norm().mean(),
+        img_scale = std::sqrt(2.0) / (p_img.rowwise() - img_mean.transpose()).rowwise().norm().mean();
+
+    // accumulate normal matrix of homogeneous system point by point
+    Eigen::Matrix<double, 12, 12> normal = Eigen::Matrix<double, 12, 12>::Zero();
+    for (long int pi = 0; pi != n; ++pi)
+    {
+        Eigen::Vector4d X;
+        X << obj_scale * obj_centered.row(pi).transpose(), 1.0;
+        const double
+            x = img_scale * (p_img(pi, 0) - img_mean.x()),
+            y = img_scale * (p_img(pi, 1) - img_mean.y());
+
+        Eigen::Matrix<double, 12, 1> r1, r2;
+        r1 << X, Eigen::Vector4d::Zero(), -x * X;
+        r2 << Eigen::Vector4d::Zero(), X, -y * X;
+        normal.noalias() += r1 * r1.transpose() + r2 * r2.transpose();
+    }
+
+    const Eigen::SelfAdjointEigenSolver<Eigen::Matrix<double, 12, 12>> es(normal);
+    const Eigen::Matrix<double, 12, 1> p = es.eigenvectors().col(0);
+
+    Eigen::Matrix<double, 3, 4> projection;
+    projection << p.segment<4>(0).transpose(),
+        p.segment<4>(4).transpose(),
+        p.segment<4>(8).transpose();
+
+    // undo normalization
+    Matrix3 img_denorm = Matrix3::Identity();
+    img_denorm(0, 0) = img_denorm(1, 1) = 1.0 / img_scale;
+    img_denorm.block<2, 1>(0, 2) = img_mean;
+    Eigen::Matrix4d obj_norm = Eigen::Matrix4d::Identity();
+    obj_norm.topLeftCorner<3, 3>() *= obj_scale;
+    obj_norm.block<3, 1>(0, 3) = -obj_scale * obj_mean;
+    projection = (img_denorm * projection * obj_norm).eval();
+
+    // projection = s * diag(-f, -f, 1) * R.T * [I | -center]
+    const Matrix3 m = projection.leftCols<3>();
+    const Vector3 center = -m.partialPivLu().solve(projection.col(3));
+    const Matrix3 scaled = Vector3(-1.0 / p_in.f, -1.0 / p_in.f, 1.0).asDiagonal() * m;
+    const double s = std::cbrt(scaled.determinant());
+    const Eigen::JacobiSVD<Matrix3> svd(scaled / s, Eigen::ComputeFullU | Eigen::ComputeFullV);
+    const Matrix3 rotate = (svd.matrixU() * svd.matrixV().transpose()).transpose();
+
+    return Exterior::makeFrom(center, rotate);
+}
+
+M_libga_end
@@ -0,0 +1,335 @@
+#include <cmath>
+#include <array>
+#include <vector>
+#include <limits>
+#include <algorithm>
+
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+
+#include <lga/Photogrammetry>
+
+M_libga_begin
+
+namespace internal
+{
+    /**
+     * @brief parameter interval `[p_t0, p_t1]` of ray `o + t * d, t >= 0` inside box `[u0, u1] x [v0, v1]`
+     *
+     */
+    bool rayBoxInterval(
+        double p_ou, double p_ov, double p_du, double p_dv,
+        double p_u0, double p_u1, double p_v0, double p_v1,
+        double &p_t0, double &p_t1) noexcept
+    {
+        p_t0 = 0.0;
+        p_t1 = std::numeric_limits<double>::infinity();
+        const std::array<std::array<double, 4>, 2> slabs{{{p_ou, p_du, p_u0, p_u1}, {p_ov, p_dv, p_v0, p_v1}}};
+        for (const auto &[o, d, lo, hi] : slabs)
+        {
+            if (d == 0.0)
+            {
+                if (o < lo || o > hi)
+                {
+                    return false;
+                }
+                continue;
+            }
+            double
+                ta = (lo - o) / d,
+                tb = (hi - o) / d;
+            if (ta > tb)
+            {
+                std::swap(ta, tb);
+            }
+            p_t0 = std::max(p_t0, ta);
+            p_t1 = std::min(p_t1, tb);
+        }
+        return p_t0 <= p_t1;
+    }
+
+    /**
+     * @brief smallest root in `[p_t0, p_t1]` of `p_a * t^2 + p_b * t + p_c`, `NaN` if there is none
+     *
+     */
+    double firstRoot(double p_a, double p_b, double p_c, double p_t0, double p_t1) noexcept
+    {
+        const double none = std::numeric_limits<double>::quiet_NaN();
+        auto inside = [&](double t)
+        { return t >= p_t0 && t <= p_t1; };
+
+        if (p_a == 0.0)
+        {
+            const double t = p_b == 0.0 ? none : -p_c / p_b;
+            return inside(t) ? t : none;
+        }
+
+        const double disc = p_b * p_b - 4 * p_a * p_c;
+        if (disc < 0.0)
+        {
+            return none;
+        }
+        const double
+            q = -0.5 * (p_b + std::copysign(std::sqrt(disc), p_b)),
+            r1 = q / p_a,
+            r2 = q == 0.0 ? r1 : p_c / q,
+            lo = std::min(r1, r2),
+            hi = std::max(r1, r2);
+        return inside(lo) ? lo : (inside(hi) ? hi : none);
+    }
+}
+
+Dem_Height_Pyramid::Dem_Height_Pyramid(const Dem_Raster &p_dem)
+    : m_dem(p_dem)
+{
+    internal::validateDemRaster(p_dem);
+    const size_t cols = p_dem.geometry.cols, rows = p_dem.geometry.rows;
+    if (!(cols >= 2 && rows >= 2))
+    {
+        throw std::invalid_argument(
+            std::format("dem of {:d} x {:d} cells has no patch to intersect", cols, rows));
+    }
+
+    Level base{
+        .cols = cols - 1,
+        .rows = rows - 1,
+        .min = std::vector<float>((cols - 1) * (rows - 1)),
+        .max = std::vector<float>((cols - 1) * (rows - 1))};
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, base.rows),
+        [&](const tbb::blocked_range<size_t> &p_range)
+        {
+            for (size_t i = p_range.begin(); i != p_range.end(); ++i)
+            {
+                for (size_t j = 0; j != base.cols; ++j)
+                {
+                    const std::array<float, 4> h{
+                        p_dem.height[i * cols + j], p_dem.height[i * cols + j + 1],
+                        p_dem.height[(i + 1) * cols + j], p_dem.height[(i + 1) * cols + j + 1]};
+                    const bool valid = std::none_of(
+                        h.begin(), h.end(),
+                        [](float p_h)
+                        { return std::isnan(p_h); });
+                    base.min[i * base.cols + j] =
+                        valid ? *std::min_element(h.begin(), h.end()) : std::numeric_limits<float>::infinity();
+                    base.max[i * base.cols + j] =
+                        valid ? *std::max_element(h.begin(), h.end()) : -std::numeric_limits<float>::infinity();
+                }
+            }
+        });
+    m_levels.push_back(std::move(base));
+
+    while (m_levels.back().cols > 1 || m_levels.back().rows > 1)
+    {
+        const Level &below = m_levels.back();
+        Level up{
+            .cols = (below.cols + 1) / 2,
+            .rows = (below.rows + 1) / 2,
+            .min = {},
+            .max = {}};
+        up.min.assign(up.cols * up.rows, std::numeric_limits<float>::infinity());
+        up.max.assign(up.cols * up.rows, -std::numeric_limits<float>::infinity());
+        for (size_t i = 0; i != below.rows; ++i)
+        {
+            for (size_t j = 0; j != below.cols; ++j)
+            {
+                float
+                    &lo = up.min[(i / 2) * up.cols + j / 2],
+                    &hi = up.max[(i / 2) * up.cols + j / 2];
+                lo = std::min(lo, below.min[i * below.cols + j]);
+                hi = std::max(hi, below.max[i * below.cols + j]);
+            }
+        }
+        m_levels.push_back(std::move(up));
+    }
+}
+
+size_t Dem_Height_Pyramid::levels() const noexcept
+{
+    return m_levels.size();
+}
+
+bool Dem_Height_Pyramid::intersect(
+    const Vector3 &p_origin, const Vector3 &p_direction, Vector3 &p_ground) const noexcept
+{
+    if (p_direction.isZero(0.0))
+    {
+        return false;
+    }
+
+    // lattice of cell centers: patch (i, j) covers u in [j, j + 1] and v in [i, i + 1]
+    const Raster_Geometry &g = m_dem.geometry;
+    const double
+        ou = (p_origin.x() - g.x) / g.gsd - 0.5,
+        ov = (g.y - p_origin.y()) / g.gsd - 0.5,
+        du = p_direction.x() / g.gsd,
+        dv = -p_direction.y() / g.gsd,
+        oz = p_origin.z(),
+        dz = p_direction.z();
+    const size_t
+        patch_cols = m_levels.front().cols,
+        patch_rows = m_levels.front().rows;
+
+    struct Node
+    {
+        size_t level, i, j;
+        double t0, t1;
+    };
+
+    // whether ray may touch terrain inside node, computes its parameter interval
+    auto enter = [&](size_t p_level, size_t p_i, size_t p_j, Node &p_node)
+    {
+        const Level &level = m_levels[p_level];
+        const float lo = level.min[p_i * level.cols + p_j], hi = level.max[p_i * level.cols + p_j];
+        if (!(lo <= hi))
+        {
+            return false;
+        }
+        p_node = {p_level, p_i, p_j, 0.0, 0.0};
+        if (!internal::rayBoxInterval(
+                ou, ov, du, dv,
+                static_cast<double>(p_j << p_level),
+                static_cast<double>(std::min((p_j + 1) << p_level, patch_cols)),
+                static_cast<double>(p_i << p_level),
+                static_cast<double>(std::min((p_i + 1) << p_level, patch_rows)),
+                p_node.t0, p_node.t1))
+        {
+            return false;
+        }
+        const double
+            z0 = oz + p_node.t0 * dz,
+            z1 = p_node.t1 == std::numeric_limits<double>::infinity()
+                     ? (dz < 0.0 ? -std::numeric_limits<double>::infinity() : std::numeric_limits<double>::infinity())
+                     : oz + p_node.t1 * dz;
+        return std::min(z0, z1) <= hi;
+    };
+
+    // depth of stack is bounded by 3 per level plus root
+    std::array<Node, 4 * 64> stack;
+    size_t top = 0;
+    if (!enter(m_levels.size() - 1, 0, 0, stack[top]))
+    {
+        return false;
+    }
+    ++top;
+
+    while (top > 0)
+    {
+        const Node node = stack[--top];
+        if (node.level == 0)
+        {
+            const size_t cols = g.cols, i = node.i, j = node.j;
+            const double
+                h00 = m_dem.height[i * cols + j],
+                h01 = m_dem.height[i * cols + j + 1],
+                h10 = m_dem.height[(i + 1) * cols + j],
+                h11 = m_dem.height[(i + 1) * cols + j + 1],
+                a0 = ou - j,
+                b0 = ov - i,
+                bu = h01 - h00,
+                bv = h10 - h00,
+                buv = h00 - h01 - h10 + h11,
+                // terrain along ray is h0 + h1 * t + h2 * t^2
+                h0 = h00 + bu * a0 + bv * b0 + buv * a0 * b0,
+                h1 = bu * du + bv * dv + buv * (a0 * dv + b0 * du),
+                h2 = buv * du * dv;
+
+            // clearance of ray above terrain
+            auto clearance = [&](double t)
+            { return oz + t * dz - (h0 + t * (h1 + t * h2)); };
+
+            // crossings exactly on a patch border may round out of both neighbours, so the interval is widened a
+            // little and a sign change over the patch is always accepted
+            const double slack = 1e-9 * std::max(1.0, std::abs(node.t1));
+            double t = node.t0;
+            if (clearance(t) > 0.0)
+            {
+                t = internal::firstRoot(-h2, dz - h1, oz - h0, node.t0 - slack, node.t1 + slack);
+                if (std::isnan(t) && std::isfinite(node.t1) && clearance(node.t1) <= 0.0)
+                {
+                    t = node.t1;
+                }
+                t = std::clamp(t, node.t0, node.t1);
+            }
+            if (!std::isnan(t))
+            {
+                p_ground = p_origin + t * p_direction;
+                return true;
+            }
+            continue;
+        }
+
+        // children, nearest on top of stack
+        std::array<Node, 4> children;
+        size_t count = 0;
+        const Level &below = m_levels[node.level - 1];
+        for (size_t ci = 2 * node.i; ci != std::min(2 * node.i + 2, below.rows); ++ci)
+        {
+            for (size_t cj = 2 * node.j; cj != std::min(2 * node.j + 2, below.cols); ++cj)
+            {
+                if (enter(node.level - 1, ci, cj, children[count]))
+                {
+                    ++count;
+                }
+            }
+        }
+        for (size_t k = 1; k < count; ++k)
+        {
+            for (size_t m = k; m > 0 && children[m - 1].t0 < children[m].t0; --m)
+            {
+                std::swap(children[m - 1], children[m]);
+            }
+        }
+        for (size_t k = 0; k != count; ++k)
+        {
+            stack[top++] = children[k];
+        }
+    }
+    return false;
+}
+
+Monoplot_Result monoplot(
+    const Image_Meta_Data &p_meta,
+    const Matrix &p_img,
+    const Dem_Height_Pyramid &p_pyramid)
+{
+    return monoplot(Oriented_Image(p_meta), p_img, p_pyramid);
+}
+
+Monoplot_Result monoplot(
+    const Oriented_Image &p_image,
+    const Matrix &p_img,
+    const Dem_Height_Pyramid &p_pyramid)
+{
+    if (p_img.cols() != 2)
+    {
+        matrixBadShape(p_img.rows(), p_img.cols(), p_img.rows(), 2);
+    }
+
+    const long int n = p_img.rows();
+
+    Monoplot_Result result{
+        .coordinate = Matrix(n, 3),
+        .hit = std::vector<char>(n, 0)};
+
+    tbb::parallel_for(
+        tbb::blocked_range<long int>(0, n),
+        [&](const tbb::blocked_range<long int> &p_range)
+        {
+            for (long int pi = p_range.begin(); pi != p_range.end(); ++pi)
+            {
+                const Vector3 direction = p_image.img2aux(Vector2(p_img(pi, 0), p_img(pi, 1)));
+                Vector3 ground;
+                if (!p_pyramid.intersect(p_image.center(), direction, ground))
+                {
+                    ground.setConstant(std::numeric_limits<double>::quiet_NaN());
+                }
+                result.hit[pi] = !std::isnan(ground.x());
+                result.coordinate.row(pi) = ground.transpose();
+            }
+        });
+
+    return result;
+}
+
+M_libga_end
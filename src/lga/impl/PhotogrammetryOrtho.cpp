@@ -0,0 +1,265 @@
+#include <cmath>
+#include <vector>
+#include <limits>
+#include <algorithm>
+
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+
+#include <lga/Photogrammetry>
+
+M_libga_begin
+
+namespace internal
+{
+    void validateRasterGeometry(const Raster_Geometry &p_geometry, std::string_view p_name)
+    {
+        if (!(p_geometry.gsd > 0.0 && p_geometry.cols > 0 && p_geometry.rows > 0))
+        {
+            throw std::invalid_argument(
+                std::format(
+                    "invalid {} raster: gsd {}, {:d} cols, {:d} rows",
+                    p_name, p_geometry.gsd, p_geometry.cols, p_geometry.rows));
+        }
+    }
+
+    void validateDemRaster(const Dem_Raster &p_dem)
+    {
+        validateRasterGeometry(p_dem.geometry, "dem");
+        if (p_dem.height.size() != p_dem.geometry.cols * p_dem.geometry.rows)
+        {
+            throw std::invalid_argument(
+                std::format(
+                    "dem has {:d} heights but {:d} x {:d} cells",
+                    p_dem.height.size(), p_dem.geometry.cols, p_dem.geometry.rows));
+        }
+    }
+
+    /**
+     * @brief bilinear height between cell centers, border cells extend to edge of raster, `NaN` outside
+     *
+     */
+    double demHeight(const Dem_Raster &p_dem, double p_x, double p_y) noexcept
+    {
+        const Raster_Geometry &g = p_dem.geometry;
+        const double
+            gc = (p_x - g.x) / g.gsd - 0.5,
+            gr = (g.y - p_y) / g.gsd - 0.5;
+        if (!(gc >= -0.5 && gc <= g.cols - 0.5 && gr >= -0.5 && gr <= g.rows - 0.5))
+        {
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+
+        const double
+            cc = std::clamp(gc, 0.0, static_cast<double>(g.cols - 1)),
+            cr = std::clamp(gr, 0.0, static_cast<double>(g.rows - 1));
+        const size_t
+            c0 = std::min(static_cast<size_t>(cc), g.cols > 1 ? g.cols - 2 : 0),
+            r0 = std::min(static_cast<size_t>(cr), g.rows > 1 ? g.rows - 2 : 0),
+            c1 = std::min(c0 + 1, g.cols - 1),
+            r1 = std::min(r0 + 1, g.rows - 1);
+        const double
+            tc = cc - c0,
+            tr = cr - r0,
+            h00 = p_dem.height[r0 * g.cols + c0],
+            h01 = p_dem.height[r0 * g.cols + c1],
+            h10 = p_dem.height[r1 * g.cols + c0],
+            h11 = p_dem.height[r1 * g.cols + c1];
+        return (1 - tr) * ((1 - tc) * h00 + tc * h01) + tr * ((1 - tc) * h10 + tc * h11);
+    }
+
+    /**
+     * @brief fill cells `[p_row_beg, p_row_end) x [p_col_beg, p_col_end)` of ortho raster, `p_band` starts at
+     * `p_band_row`
+     *
+     */
+    void orthoTile(
+        const Oriented_Image &p_oriented,
+        const Dem_Raster &p_dem,
+        const Image_Raster &p_image,
+        const Raster_Geometry &p_ortho,
+        std::uint8_t p_no_data,
+        size_t p_band_row,
+        size_t p_row_beg, size_t p_row_end,
+        size_t p_col_beg, size_t p_col_end,
+        std::uint8_t *p_band) noexcept
+    {
+        const Exterior &ex = p_oriented.exterior();
+        const Interior &in = p_oriented.interior();
+        const Matrix3 &rotate = p_oriented.rotate();
+        const size_t channels = p_image.channels;
+        const Lens_Distortion *distortion = in.undistortion ? &in.undistortion->distortion() : nullptr;
+        const double
+            r00 = rotate(0, 0), r01 = rotate(0, 1), r02 = rotate(0, 2),
+            r10 = rotate(1, 0), r11 = rotate(1, 1), r12 = rotate(1, 2),
+            r20 = rotate(2, 0), r21 = rotate(2, 1), r22 = rotate(2, 2),
+            neg_f = -in.f,
+            inv_pixel = 1.0 / p_image.pixel_size,
+            col_offset = 0.5 * p_image.cols - 0.5,
+            row_offset = 0.5 * p_image.rows - 0.5,
+            max_col = p_image.cols - 1.0,
+            max_row = p_image.rows - 1.0;
+        const std::uint8_t *src = p_image.data.data();
+
+        for (size_t r = p_row_beg; r != p_row_end; ++r)
+        {
+            const double y = p_ortho.y - (r + 0.5) * p_ortho.gsd;
+            std::uint8_t *dst = p_band + ((r - p_band_row) * p_ortho.cols + p_col_beg) * channels;
+            for (size_t c = p_col_beg; c != p_col_end; ++c, dst += channels)
+            {
+                const double x = p_ortho.x + (c + 0.5) * p_ortho.gsd;
+                const double z = demHeight(p_dem, x, y);
+
+                const double
+                    dx = x - ex.x,
+                    dy = y - ex.y,
+                    dz = z - ex.z,
+                    w = r02 * dx + r12 * dy + r22 * dz;
+                // NaN height fails this test as well
+                if (!(w < 0.0))
+                {
+                    std::fill_n(dst, channels, p_no_data);
+                    continue;
+                }
+                const double s = neg_f / w;
+                Vector2 img(s * (r00 * dx + r10 * dy + r20 * dz), s * (r01 * dx + r11 * dy + r21 * dz));
+                if (distortion)
+                {
+                    img = distort3(img, *distortion);
+                }
+
+                const double
+                    pc = img.x() * inv_pixel + col_offset,
+                    pr = row_offset - img.y() * inv_pixel;
+                if (!(pc >= 0.0 && pc <= max_col && pr >= 0.0 && pr <= max_row))
+                {
+                    std::fill_n(dst, channels, p_no_data);
+                    continue;
+                }
+
+                const size_t
+                    c0 = std::min(static_cast<size_t>(pc), p_image.cols > 1 ? p_image.cols - 2 : 0),
+                    r0 = std::min(static_cast<size_t>(pr), p_image.rows > 1 ? p_image.rows - 2 : 0),
+                    c1 = std::min(c0 + 1, p_image.cols - 1),
+                    r1 = std::min(r0 + 1, p_image.rows - 1);
+                const double
+                    tc = pc - c0,
+                    tr = pr - r0,
+                    w00 = (1 - tc) * (1 - tr),
+                    w01 = tc * (1 - tr),
+                    w10 = (1 - tc) * tr,
+                    w11 = tc * tr;
+                const std::uint8_t
+                    *p00 = src + (r0 * p_image.cols + c0) * channels,
+                    *p01 = src + (r0 * p_image.cols + c1) * channels,
+                    *p10 = src + (r1 * p_image.cols + c0) * channels,
+                    *p11 = src + (r1 * p_image.cols + c1) * channels;
+                for (size_t k = 0; k != channels; ++k)
+                {
+                    dst[k] = static_cast<std::uint8_t>(
+                        w00 * p00[k] + w01 * p01[k] + w10 * p10[k] + w11 * p11[k] + 0.5);
+                }
+            }
+        }
+    }
+}
+
+void orthorectify(
+    const Image_Meta_Data &p_meta,
+    const Dem_Raster &p_dem,
+    const Image_Raster &p_image,
+    const Raster_Geometry &p_ortho,
+    const Ortho_Band_Sink &p_sink,
+    Ortho_Option p_option)
+{
+    orthorectify(Oriented_Image(p_meta), p_dem, p_image, p_ortho, p_sink, p_option);
+}
+
+void orthorectify(
+    const Image_Meta_Data &p_meta,
+    const Dem_Raster &p_dem,
+    const Image_Raster &p_image,
+    const Raster_Geometry &p_ortho,
+    std::span<std::uint8_t> p_out,
+    Ortho_Option p_option)
+{
+    orthorectify(Oriented_Image(p_meta), p_dem, p_image, p_ortho, p_out, p_option);
+}
+
+void orthorectify(
+    const Oriented_Image &p_oriented,
+    const Dem_Raster &p_dem,
+    const Image_Raster &p_image,
+    const Raster_Geometry &p_ortho,
+    const Ortho_Band_Sink &p_sink,
+    Ortho_Option p_option)
+{
+    internal::validateDemRaster(p_dem);
+    internal::validateRasterGeometry(p_ortho, "ortho");
+    if (!(p_image.cols > 0 && p_image.rows > 0 && p_image.channels > 0 && p_image.pixel_size > 0.0 &&
+          p_image.data.size() == p_image.cols * p_image.rows * p_image.channels))
+    {
+        throw std::invalid_argument(
+            std::format(
+                "invalid image raster: {:d} bytes for {:d} x {:d} x {:d}, pixel size {}",
+                p_image.data.size(), p_image.cols, p_image.rows, p_image.channels, p_image.pixel_size));
+    }
+    if (p_option.tile == 0)
+    {
+        throw std::invalid_argument("tile size of orthorectification is 0");
+    }
+
+    const size_t
+        tile = p_option.tile,
+        tiles = (p_ortho.cols + tile - 1) / tile;
+    std::vector<std::uint8_t> band(std::min(tile, p_ortho.rows) * p_ortho.cols * p_image.channels);
+
+    for (size_t first = 0; first < p_ortho.rows; first += tile)
+    {
+        const size_t last = std::min(first + tile, p_ortho.rows);
+        tbb::parallel_for(
+            tbb::blocked_range<size_t>(0, tiles),
+            [&](const tbb::blocked_range<size_t> &p_range)
+            {
+                for (size_t ti = p_range.begin(); ti != p_range.end(); ++ti)
+                {
+                    internal::orthoTile(
+                        p_oriented, p_dem, p_image, p_ortho, p_option.no_data,
+                        first, first, last,
+                        ti * tile, std::min((ti + 1) * tile, p_ortho.cols),
+                        band.data());
+                }
+            });
+        p_sink(
+            first, last - first,
+            std::span<const std::uint8_t>(band).first((last - first) * p_ortho.cols * p_image.channels));
+    }
+}
+
+void orthorectify(
+    const Oriented_Image &p_oriented,
+    const Dem_Raster &p_dem,
+    const Image_Raster &p_image,
+    const Raster_Geometry &p_ortho,
+    std::span<std::uint8_t> p_out,
+    Ortho_Option p_option)
+{
+    const size_t row_bytes = p_ortho.cols * p_image.channels;
+    if (p_out.size() != row_bytes * p_ortho.rows)
+    {
+        throw std::invalid_argument(
+            std::format(
+                "output has {:d} bytes but ortho raster needs {:d}",
+                p_out.size(), row_bytes * p_ortho.rows));
+    }
+
+    orthorectify(
+        p_oriented, p_dem, p_image, p_ortho,
+        [&](size_t p_first_row, [[maybe_unused]] size_t p_rows, std::span<const std::uint8_t> p_band)
+        {
+            std::copy(p_band.begin(), p_band.end(), p_out.begin() + p_first_row * row_bytes);
+        },
+        p_option);
+}
+
+M_libga_end
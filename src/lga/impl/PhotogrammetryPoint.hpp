@@ -0,0 +1,95 @@
+/**
+ * @file PhotogrammetryPoint.hpp
+ * @author WZYivan (227006975@qq.com)
+ * @brief inline Gauss-Newton kernel refining one object point from its image observations
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef M_libga_impl_photogrammetry_point
+#define M_libga_impl_photogrammetry_point
+
+#include <cmath>
+#include <utility>
+#include <algorithm>
+
+#include <lga/Photogrammetry>
+
+M_libga_begin
+
+/** @cond */
+namespace internal
+{
+    struct Point_Refinement
+    {
+        bool converged;
+        double rmse;
+        Vector3 std_error;
+    };
+
+    /**
+     * @brief Gauss-Newton refinement of one object point shared by batch intersection and track triangulation.
+     * `p_linearize(i, obj, b, l)` fills the (2, 3) design matrix `b` and misclosure `l` of observation `i` at `obj`.
+     *
+     * @param p_obj initial object point, refined in place
+     * @param p_count observations of the point, at least 2
+     */
+    template <typename Linearize>
+    inline Point_Refinement refinePoint(
+        Vector3 &p_obj,
+        size_t p_count,
+        Linearize &&p_linearize,
+        size_t p_max_loop,
+        double p_threshold)
+    {
+        Point_Refinement result{.converged = false, .rmse = 0.0, .std_error = Vector3::Zero()};
+        Matrix3 normal = Matrix3::Zero();
+        Vector3
+            rhs = Vector3::Zero(),
+            correction = Vector3::Zero();
+        Eigen::LDLT<Matrix3> ldlt(normal);
+        Eigen::Matrix<double, 2, 3> b;
+        Vector2 l;
+        double vtv = 0.0;
+
+        for (size_t loop = 0; loop != p_max_loop; ++loop)
+        {
+            normal.setZero();
+            rhs.setZero();
+            vtv = 0.0;
+            for (size_t i = 0uz; i != p_count; ++i)
+            {
+                p_linearize(i, std::as_const(p_obj), b, l);
+                normal.noalias() += b.transpose() * b;
+                rhs.noalias() += b.transpose() * l;
+                vtv += l.squaredNorm();
+            }
+
+            ldlt.compute(normal);
+            correction = ldlt.solve(rhs);
+            if (!correction.allFinite())
+            {
+                break;
+            }
+            if (correction.cwiseAbs().maxCoeff() < p_threshold)
+            {
+                result.converged = true;
+                break;
+            }
+            p_obj += correction;
+        }
+
+        // vtv = ltl - x.T * u, two observations leave one redundancy
+        result.rmse = std::sqrt(std::max(vtv - correction.dot(rhs), 0.0) / (2.0 * p_count - 3.0));
+        // cofactor diagonal from the factorization of last iteration
+        result.std_error = result.rmse * ldlt.solve(Matrix3::Identity()).diagonal().cwiseSqrt();
+        return result;
+    }
+}
+/** @endcond */
+
+M_libga_end
+
+#endif
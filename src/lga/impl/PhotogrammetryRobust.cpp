@@ -0,0 +1,252 @@
+#include <cmath>
+#include <vector>
+#include <limits>
+#include <array>
+#include <random>
+#include <algorithm>
+
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+
+#include <lga/Photogrammetry>
+
+M_libga_begin
+
+namespace internal
+{
+    /**
+     * @brief number of samples scored in parallel before the stop criterion is checked again
+     *
+     */
+    constexpr size_t ransac_round = 64;
+
+    struct Ransac_Hypothesis
+    {
+        Exterior exterior{};
+        double cost = std::numeric_limits<double>::infinity();
+        size_t inlier_count = 0;
+    };
+
+    /**
+     * @brief truncated quadratic cost (MSAC) of exterior over all control points, points behind camera count as
+     * outliers
+     *
+     */
+    Ransac_Hypothesis scoreHypothesis(
+        const Interior &p_in, const Matrix &p_img, const Matrix &p_obj, const Exterior &p_ex, double p_threshold2)
+    {
+        const Matrix3 rotate = ex2yxzRotation3(p_ex);
+        Ransac_Hypothesis h{.exterior = p_ex, .cost = 0.0, .inlier_count = 0};
+        for (long int pi = 0; pi != p_obj.rows(); ++pi)
+        {
+            const Vector3 isp = obj2isp3(p_obj.row(pi).transpose(), p_ex, rotate);
+            double e2 = p_threshold2;
+            if (isp.z() < 0.0)
+            {
+                e2 = std::min(e2, (isp2img3(isp, p_in) - p_img.row(pi).transpose()).squaredNorm());
+            }
+            if (e2 < p_threshold2)
+            {
+                ++h.inlier_count;
+            }
+            h.cost += e2;
+        }
+        return h;
+    }
+
+    /**
+     * @brief number of samples needed to draw one outlier free triple with given confidence
+     *
+     */
+    size_t ransacTrialsNeeded(size_t p_inliers, size_t p_total, double p_confidence, size_t p_max_trials) noexcept
+    {
+        const double w = static_cast<double>(p_inliers) / static_cast<double>(p_total);
+        const double outlier_free = w * w * w;
+        if (outlier_free >= 1.0)
+        {
+            return 1;
+        }
+        if (outlier_free <= 0.0)
+        {
+            return p_max_trials;
+        }
+        const double k = std::ceil(std::log(1.0 - p_confidence) / std::log(1.0 - outlier_free));
+        return k < static_cast<double>(p_max_trials) ? static_cast<size_t>(std::max(k, 1.0)) : p_max_trials;
+    }
+
+    std::vector<char> ransacInliers(
+        const Interior &p_in, const Matrix &p_img, const Matrix &p_obj, const Exterior &p_ex, double p_threshold2)
+    {
+        const Matrix3 rotate = ex2yxzRotation3(p_ex);
+        std::vector<char> inliers(p_obj.rows(), 0);
+        for (long int pi = 0; pi != p_obj.rows(); ++pi)
+        {
+            const Vector3 isp = obj2isp3(p_obj.row(pi).transpose(), p_ex, rotate);
+            inliers[pi] = isp.z() < 0.0 &&
+                          (isp2img3(isp, p_in) - p_img.row(pi).transpose()).squaredNorm() < p_threshold2;
+        }
+        return inliers;
+    }
+
+    std::pair<Matrix, Matrix> selectRows(const Matrix &p_img, const Matrix &p_obj, const std::vector<char> &p_mask)
+    {
+        const long int n = std::count(p_mask.begin(), p_mask.end(), 1);
+        Matrix img(n, 2), obj(n, 3);
+        for (long int pi = 0, ri = 0; pi != p_obj.rows(); ++pi)
+        {
+            if (p_mask[pi])
+            {
+                img.row(ri) = p_img.row(pi);
+                obj.row(ri) = p_obj.row(pi);
+                ++ri;
+            }
+        }
+        return {img, obj};
+    }
+}
+
+Robust_Space_Resection_Result
+robustSpaceResection(
+    const Interior &p_in,
+    const Matrix &p_img,
+    const Matrix &p_obj,
+    Ransac_Option p_option,
+    size_t p_max_loop,
+    double p_threshold,
+    Collinearity_Condition_Equation_Coefficient_Solver p_cce_solver,
+    Iterative_Step_Option p_step,
+    Rotation_Parameterization p_rotation)
+{
+    internal::validateSpaceResectionInput(p_img, p_obj);
+    if (p_in.undistortion)
+    {
+        return robustSpaceResection(
+            internal::idealInterior(p_in), internal::undistortImage(p_in, p_img), p_obj, p_option, p_max_loop,
+            p_threshold, p_cce_solver, p_step, p_rotation);
+    }
+    if (!(p_option.threshold > 0.0 && p_option.confidence > 0.0 && p_option.confidence < 1.0))
+    {
+        throw std::invalid_argument(
+            std::format(
+                "invalid ransac option: threshold = {}, confidence = {}",
+                p_option.threshold,
+                p_option.confidence));
+    }
+
+    const size_t n = p_img.rows();
+    const double threshold2 = p_option.threshold * p_option.threshold;
+
+    std::vector<Vector3> bearing(n);
+    for (size_t pi = 0; pi != n; ++pi)
+    {
+        bearing[pi] = internal::imageBearing(p_img(pi, 0), p_img(pi, 1), p_in);
+    }
+
+    // samples are drawn serially so that result only depends on seed, scoring runs in parallel
+    std::mt19937 gen(p_option.seed);
+    std::uniform_int_distribution<size_t> pick(0, n - 1);
+    std::vector<std::array<size_t, 3>> samples;
+    std::vector<internal::Ransac_Hypothesis> scored;
+
+    internal::Ransac_Hypothesis best;
+    size_t trials = 0, needed = p_option.max_trials;
+    while (trials < needed)
+    {
+        const size_t round = std::min(internal::ransac_round, needed - trials);
+        samples.resize(round);
+        for (std::array<size_t, 3> &s : samples)
+        {
+            s[0] = pick(gen);
+            do
+            {
+                s[1] = pick(gen);
+            } while (s[1] == s[0]);
+            do
+            {
+                s[2] = pick(gen);
+            } while (s[2] == s[0] || s[2] == s[1]);
+        }
+
+        scored.assign(round, {});
+        tbb::parallel_for(
+            tbb::blocked_range<size_t>(0, round),
+            [&](const tbb::blocked_range<size_t> &p_range)
+            {
+                for (size_t si = p_range.begin(); si != p_range.end(); ++si)
+                {
+                    const std::array<size_t, 3> &s = samples[si];
+                    for (const auto &[rotate, center] : internal::p3pCandidates(
+                             {bearing[s[0]], bearing[s[1]], bearing[s[2]]},
+                             {p_obj.row(s[0]).transpose(), p_obj.row(s[1]).transpose(), p_obj.row(s[2]).transpose()}))
+                    {
+                        internal::Ransac_Hypothesis h = internal::scoreHypothesis(
+                            p_in, p_img, p_obj, Exterior::makeFrom(center, rotate), threshold2);
+                        if (h.cost < scored[si].cost)
+                        {
+                            scored[si] = h;
+                        }
+                    }
+                }
+            });
+
+        // reduce in sample order, keeps result independent of scheduling
+        for (const internal::Ransac_Hypothesis &h : scored)
+        {
+            if (h.cost < best.cost)
+            {
+                best = h;
+            }
+        }
+        trials += round;
+        needed = internal::ransacTrialsNeeded(best.inlier_count, n, p_option.confidence, p_option.max_trials);
+    }
+
+    Robust_Space_Resection_Result result;
+    result.trials = trials;
+    result.resection.info = Iterative_Algo_Info::NOT_CONVERGED;
+    if (best.inlier_count < 4)
+    {
+        result.inliers.assign(n, 0);
+        result.inlier_count = best.inlier_count;
+        if (std::isfinite(best.cost))
+        {
+            result.resection.exterior = best.exterior;
+            result.resection.rotate = ex2yxzRotation(best.exterior);
+            result.resection.rmse = std::sqrt(best.cost / static_cast<double>(n));
+            result.inliers = internal::ransacInliers(p_in, p_img, p_obj, best.exterior, threshold2);
+        }
+        return result;
+    }
+
+    // refine on consensus set, then once more if refined exterior gathers a different set
+    std::vector<char> inliers = internal::ransacInliers(p_in, p_img, p_obj, best.exterior, threshold2);
+    Exterior start = best.exterior;
+    for (int pass = 0; pass != 2; ++pass)
+    {
+        const auto [img, obj] = internal::selectRows(p_img, p_obj, inliers);
+        result.resection = spaceResection(
+            p_in, img, obj, p_max_loop, p_threshold, p_cce_solver, {},
+            [&start](const Interior &, const Matrix &, const Matrix &)
+            { return start; },
+            p_step, p_rotation);
+
+        if (pass == 1)
+        {
+            break;
+        }
+        std::vector<char> refined =
+            internal::ransacInliers(p_in, p_img, p_obj, result.resection.exterior, threshold2);
+        if (refined == inliers || std::count(refined.begin(), refined.end(), 1) < 4)
+        {
+            break;
+        }
+        inliers = std::move(refined);
+        start = result.resection.exterior;
+    }
+
+    result.inlier_count = std::count(inliers.begin(), inliers.end(), 1);
+    result.inliers = std::move(inliers);
+    return result;
+}
+
+M_libga_end
@@ -0,0 +1,153 @@
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+
+#include <lga/Photogrammetry>
+#include <lga/impl/PhotogrammetryPoint.hpp>
+
+M_libga_begin
+
+namespace internal
+{
+    void validateTracks(
+        size_t p_images,
+        std::span<const Track_Observation> p_observations,
+        std::span<const size_t> p_offsets)
+    {
+        if (p_offsets.empty() || p_offsets.front() != 0 || p_offsets.back() != p_observations.size())
+        {
+            throw std::invalid_argument(
+                std::format(
+                    "track offsets must run from 0 to {:d} observations",
+                    p_observations.size()));
+        }
+        for (size_t t = 0; t + 1 < p_offsets.size(); ++t)
+        {
+            if (!(p_offsets[t] + 2 <= p_offsets[t + 1]))
+            {
+                throw std::invalid_argument(std::format("track `{:d}` has less than 2 observations", t));
+            }
+        }
+        for (const Track_Observation &obs : p_observations)
+        {
+            if (obs.image >= p_images)
+            {
+                throw std::invalid_argument(std::format("image `{:d}` out of range", obs.image));
+            }
+        }
+    }
+
+    /**
+     * @brief linear triangulation of one track, each observation adds the rows `f * r1 + x * r3` and
+     * `f * r2 + y * r3` which are orthogonal to object point minus projection center. Rows are normalized and the
+     * point is solved relative to the first projection center to keep normal equation well conditioned.
+     *
+     */
+    Vector3 linearTriangulation(
+        std::span<const Oriented_Image> p_images,
+        std::span<const Track_Observation> p_track) noexcept
+    {
+        const Vector3 &origin = p_images[p_track.front().image].center();
+        Matrix3 normal = Matrix3::Zero();
+        Vector3 rhs = Vector3::Zero();
+        for (const Track_Observation &obs : p_track)
+        {
+            const Oriented_Image &image = p_images[obs.image];
+            const Matrix3 &rotate = image.rotate();
+            const double f = image.interior().f;
+            const Vector3 offset = image.center() - origin;
+            for (const Vector3 &a : {
+                     Vector3(f * rotate.col(0) + obs.x * rotate.col(2)),
+                     Vector3(f * rotate.col(1) + obs.y * rotate.col(2))})
+            {
+                const Vector3 row = a.normalized();
+                normal.noalias() += row * row.transpose();
+                rhs += row * row.dot(offset);
+            }
+        }
+        return origin + normal.ldlt().solve(rhs);
+    }
+}
+
+Space_Intersection_Batch_Result
+triangulateTracks(
+    std::span<const Oriented_Image> p_images,
+    std::span<const Track_Observation> p_observations,
+    std::span<const size_t> p_offsets,
+    size_t p_max_loop,
+    double p_threshold)
+{
+    internal::validateTracks(p_images.size(), p_observations, p_offsets);
+
+    std::vector<Track_Observation> undistorted;
+    if (std::any_of(p_images.begin(), p_images.end(), [](const Oriented_Image &p_image)
+                    { return p_image.interior().undistortion != nullptr; }))
+    {
+        undistorted.assign(p_observations.begin(), p_observations.end());
+        for (Track_Observation &obs : undistorted)
+        {
+            if (const Undistortion_Grid *grid = p_images[obs.image].interior().undistortion.get())
+            {
+                const Vector2 img = grid->undistort3(Vector2(obs.x, obs.y));
+                obs.x = img.x();
+                obs.y = img.y();
+            }
+        }
+        p_observations = undistorted;
+    }
+
+    const long int tracks = static_cast<long int>(p_offsets.size()) - 1;
+    Space_Intersection_Batch_Result result{
+        .coordinate = Matrix(tracks, 3),
+        .std_error = Matrix(tracks, 3),
+        .rmse = Vector(tracks),
+        .converged = std::vector<char>(tracks, 0)};
+
+    tbb::parallel_for(
+        tbb::blocked_range<long int>(0, tracks),
+        [&](const tbb::blocked_range<long int> &p_range)
+        {
+            for (long int t = p_range.begin(); t != p_range.end(); ++t)
+            {
+                const std::span<const Track_Observation> track =
+                    p_observations.subspan(p_offsets[t], p_offsets[t + 1] - p_offsets[t]);
+                Vector3 obj = internal::linearTriangulation(p_images, track);
+                const internal::Point_Refinement refined = internal::refinePoint(
+                    obj, track.size(),
+                    [&](size_t i, const Vector3 &p_obj, Eigen::Matrix<double, 2, 3> &p_b, Vector2 &p_l)
+                    {
+                        const Track_Observation &obs = track[i];
+                        const Oriented_Image &image = p_images[obs.image];
+                        const Matrix3 &rotate = image.rotate();
+                        const double f = image.interior().f;
+                        const Vector3 isp = image.obj2isp(p_obj);
+                        const double
+                            x = -f * isp.x() / isp.z(),
+                            y = -f * isp.y() / isp.z();
+                        p_l << obs.x - x, obs.y - y;
+
+                        // partial derivatives of image coordinates to object coordinates, same as `-a11` ... `-a23`
+                        // of `cceSimplifyNone` but without trigonometric functions
+                        p_b.row(0) = -(f * rotate.col(0) + x * rotate.col(2)).transpose() / isp.z();
+                        p_b.row(1) = -(f * rotate.col(1) + y * rotate.col(2)).transpose() / isp.z();
+                    },
+                    p_max_loop, p_threshold);
+
+                result.coordinate.row(t) = obj.transpose();
+                result.rmse(t) = refined.rmse;
+                result.std_error.row(t) = refined.std_error.transpose();
+                result.converged[t] = refined.converged;
+            }
+        });
+
+    result.info = std::all_of(result.converged.begin(), result.converged.end(), [](char p_c)
+                              { return p_c != 0; })
+                      ? Iterative_Algo_Info::SUCCESS
+                      : Iterative_Algo_Info::NOT_CONVERGED;
+    return result;
+}
+
+M_libga_end
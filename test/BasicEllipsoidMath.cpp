@@ -1,9 +1,11 @@
 #include <print>
+#include <vector>
 #include <iostream>
 
 #include <lga/Geodesy>
 
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
 
 using namespace Catch::Matchers;
@@ -21,5 +23,52 @@ TEST_CASE("basic ellipsoid math")
             double db = rad2sec(B.rad() - B_inv.rad());
             REQUIRE_THAT(db, WithinAbs(0, 1e-3));
         }
+
+        // closed form footpoint latitude holds between sample latitudes as well
+        for (const Ellipsoid *ellipsoid : {&krassovsky, &ie1975, &wgs84, &cgcs2000})
+        {
+            for (int i = -900; i <= 900; ++i)
+            {
+                Latitude B(deg2rad(i / 10.0));
+                Latitude B_inv = meridianArcBottom(meridianArcLength(B, *ellipsoid), *ellipsoid);
+                REQUIRE_THAT(rad2sec(B.rad() - B_inv.rad()), WithinAbs(0, 1e-5));
+            }
+        }
+    }
+}
+
+TEST_CASE("meridian arc bottom benchmark", "[.][benchmark]")
+{
+    const size_t n = 100'000;
+    std::vector<double> len(n), lat(n), lon(n, deg2rad(117.0)), x(n), y(n);
+    std::vector<int> zones(n);
+    for (size_t i = 0; i != n; ++i)
+    {
+        lat[i] = deg2rad(80.0 * i / n);
+        len[i] = meridianArcLength(Latitude(lat[i]), cgcs2000);
+    }
+
+    double max_error = 0.0;
+    for (size_t i = 0; i != n; ++i)
+    {
+        max_error = std::max(max_error, std::abs(rad2sec(meridianArcBottom(len[i], cgcs2000).rad() - lat[i])));
     }
-}
\ No newline at end of file
+    std::println("max round trip error of meridian arc bottom: {:.3e}\"", max_error);
+
+    BENCHMARK("meridian arc bottom")
+    {
+        double sum = 0.0;
+        for (size_t i = 0; i != n; ++i)
+        {
+            sum += meridianArcBottom(len[i], cgcs2000).rad();
+        }
+        return sum;
+    };
+
+    gauss_project.forward(lat, lon, 6.0, cgcs2000, x, y, zones);
+    BENCHMARK("gauss batch inverse")
+    {
+        gauss_project.inverse(x, y, zones, 6.0, cgcs2000, lat, lon);
+        return lat[n / 2];
+    };
+}
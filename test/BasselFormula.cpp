@@ -1,9 +1,15 @@
+#include <cmath>
 #include <print>
+#include <vector>
+#include <numbers>
+#include <algorithm>
 #include <iostream>
 
 #include <lga/Geodesy>
+#include <lga/GeodesySolver>
 
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
 
 using namespace Catch::Matchers;
@@ -26,4 +32,170 @@ TEST_CASE("bessel formula solve")
         REQUIRE_THAT(da, WithinAbs(0, 1));
         REQUIRE_THAT(ds, WithinAbs(0, 1));
     }
-}
\ No newline at end of file
+
+    SECTION("azimuths lie in [0, 2 pi) along meridian")
+    {
+        Geodetic_Inverse_Solve_Result
+            south = bessel_formula_solve(
+                Latitude(deg2rad(30.0)), Longitude(deg2rad(110.0)),
+                Latitude(deg2rad(20.0)), Longitude(deg2rad(110.0)), krassovsky),
+            north = bessel_formula_solve(
+                Latitude(deg2rad(20.0)), Longitude(deg2rad(110.0)),
+                Latitude(deg2rad(30.0)), Longitude(deg2rad(110.0)), krassovsky);
+        REQUIRE(south.backward.toRadian() >= 0.0);
+        REQUIRE(south.backward.toRadian() < 2 * std::numbers::pi);
+        REQUIRE_THAT(south.backward.toRadian(), WithinAbs(0, 1e-12));
+        REQUIRE_THAT(south.forward.toRadian(), WithinAbs(std::numbers::pi, 1e-12));
+        REQUIRE_THAT(north.backward.toRadian(), WithinAbs(std::numbers::pi, 1e-12));
+        REQUIRE_THAT(north.forward.toRadian(), WithinAbs(0, 1e-12));
+    }
+
+    SECTION("batch inverse matrix same as scalar solve")
+    {
+        std::vector<double> lat_1, lon_1, lat_2, lon_2;
+        for (int i = 0; i != 13; ++i)
+        {
+            lat_1.push_back(deg2rad(20.0 + 2.1 * i));
+            lon_1.push_back(deg2rad(100.0 + 1.7 * i));
+        }
+        for (int j = 0; j != 70; ++j)
+        {
+            lat_2.push_back(deg2rad(25.0 + 0.37 * j));
+            lon_2.push_back(deg2rad(110.0 - 0.29 * j));
+        }
+        const size_t n = lat_1.size(), m = lat_2.size();
+        std::vector<double> s(n * m), forward(n * m), backward(n * m);
+        besselFormulaInverseMatrix(lat_1, lon_1, lat_2, lon_2, krassovsky, s, forward, backward);
+        for (size_t i = 0; i != n; ++i)
+        {
+            for (size_t j = 0; j != m; ++j)
+            {
+                Geodetic_Inverse_Solve_Result r = bessel_formula_solve(
+                    Latitude(lat_1[i]), Longitude(lon_1[i]), Latitude(lat_2[j]), Longitude(lon_2[j]), krassovsky);
+                REQUIRE(s[i * m + j] == r.s);
+                REQUIRE(forward[i * m + j] == r.forward.toRadian());
+                REQUIRE(backward[i * m + j] == r.backward.toRadian());
+            }
+        }
+
+        // symmetric matrix of first set, mirrored azimuths agree within precision of backward azimuth
+        std::vector<double> sym_s(n * n), sym_forward(n * n), sym_backward(n * n);
+        besselFormulaInverseMatrix(lat_1, lon_1, krassovsky, sym_s, sym_forward, sym_backward);
+        for (size_t i = 0; i != n; ++i)
+        {
+            REQUIRE(sym_s[i * n + i] == 0.0);
+            REQUIRE(std::isnan(sym_forward[i * n + i]));
+            for (size_t j = 0; j != n; ++j)
+            {
+                if (i == j)
+                {
+                    continue;
+                }
+                Geodetic_Inverse_Solve_Result r = bessel_formula_solve(
+                    Latitude(lat_1[i]), Longitude(lon_1[i]), Latitude(lat_1[j]), Longitude(lon_1[j]), krassovsky);
+                REQUIRE_THAT(sym_s[i * n + j], WithinAbs(r.s, 1e-3));
+                REQUIRE_THAT(
+                    rad2sec(std::remainder(sym_forward[i * n + j] - r.forward.toRadian(), 2 * std::numbers::pi)),
+                    WithinAbs(0, 1));
+                REQUIRE_THAT(
+                    rad2sec(std::remainder(sym_backward[i * n + j] - r.backward.toRadian(), 2 * std::numbers::pi)),
+                    WithinAbs(0, 1));
+            }
+        }
+
+        std::vector<double> only_s(n * n);
+        besselFormulaInverseMatrix(lat_1, lon_1, krassovsky, only_s);
+        REQUIRE(only_s == sym_s);
+        REQUIRE_THROWS_AS(besselFormulaInverseMatrix(lat_1, lon_1, krassovsky, s), std::invalid_argument);
+        REQUIRE_THROWS_AS(
+            besselFormulaInverseMatrix(lat_1, lon_2, lat_2, lon_2, krassovsky, s),
+            std::invalid_argument);
+    }
+
+    SECTION("policy batch same as solver facade")
+    {
+        std::vector<double> lat_1, lon_1, lat_2, lon_2, s, forward;
+        for (int i = 0; i != 300; ++i)
+        {
+            lat_1.push_back(deg2rad(-60.0 + 0.4 * i));
+            lon_1.push_back(deg2rad(10.0 + 0.3 * i));
+            lat_2.push_back(deg2rad(-50.0 + 0.35 * i));
+            lon_2.push_back(deg2rad(40.0 - 0.2 * i));
+            s.push_back(1'000.0 + 3'000.0 * i);
+            forward.push_back(deg2rad(1.0 + 1.19 * i));
+        }
+        const size_t n = lat_1.size();
+        std::vector<double> r_s(n), r_forward(n), r_backward(n), r_lat(n), r_lon(n);
+        geodeticInverse<Bessel_Formula>(lat_1, lon_1, lat_2, lon_2, krassovsky, r_s, r_forward, r_backward);
+        geodeticForward<Bessel_Formula>(lat_1, lon_1, s, forward, krassovsky, r_lat, r_lon, r_backward);
+        for (size_t i = 0; i != n; ++i)
+        {
+            Geodetic_Inverse_Solve_Result ri = bessel_formula_solve(
+                Latitude(lat_1[i]), Longitude(lon_1[i]), Latitude(lat_2[i]), Longitude(lon_2[i]), krassovsky);
+            REQUIRE(r_s[i] == ri.s);
+            REQUIRE(r_forward[i] == ri.forward.toRadian());
+
+            Geodetic_Forward_Solve_Result rf = bessel_formula_solve(
+                Latitude(lat_1[i]), Longitude(lon_1[i]), s[i], Angle(forward[i]), krassovsky);
+            REQUIRE(r_lat[i] == rf.lat.rad());
+            REQUIRE(r_lon[i] == rf.lon.rad());
+            REQUIRE(r_backward[i] == rf.backward.toRadian());
+        }
+
+        REQUIRE_THROWS_AS(
+            geodeticInverse<Bessel_Formula>(lat_1, lon_1, lat_2, lon_2, krassovsky, r_s, r_forward, std::span(r_lat).first(1)),
+            std::invalid_argument);
+
+        // inputs are checked before the parallel part, outputs are left untouched
+        std::vector<double> bad_lat = lat_2;
+        bad_lat[n / 2] = deg2rad(91.0);
+        std::fill(r_s.begin(), r_s.end(), -1.0);
+        REQUIRE_THROWS_AS(
+            geodeticInverse<Bessel_Formula>(lat_1, lon_1, bad_lat, lon_2, krassovsky, r_s, r_forward, r_backward),
+            std::invalid_argument);
+        REQUIRE(std::all_of(r_s.begin(), r_s.end(), [](double p_s)
+                            { return p_s == -1.0; }));
+        REQUIRE_THROWS_AS(
+            geodeticForward<Bessel_Formula>(bad_lat, lon_1, s, forward, krassovsky, r_lat, r_lon, r_backward),
+            std::invalid_argument);
+    }
+}
+
+TEST_CASE("bessel formula batch benchmark", "[.][benchmark]")
+{
+    const size_t n = 20'000;
+    std::vector<double> lat_1(n), lon_1(n), lat_2(n), lon_2(n), s(n), forward(n), backward(n);
+    for (size_t i = 0; i != n; ++i)
+    {
+        lat_1[i] = deg2rad(20.0 + 30.0 * i / n);
+        lon_1[i] = deg2rad(100.0 + (i % 97) * 0.1);
+        lat_2[i] = deg2rad(25.0 + 20.0 * i / n);
+        lon_2[i] = deg2rad(110.0 - (i % 89) * 0.1);
+    }
+
+    BENCHMARK("facade inverse loop")
+    {
+        for (size_t i = 0; i != n; ++i)
+        {
+            s[i] = bessel_formula_solve(
+                       Latitude(lat_1[i]), Longitude(lon_1[i]), Latitude(lat_2[i]), Longitude(lon_2[i]), krassovsky)
+                       .s;
+        }
+        return s[n / 2];
+    };
+    BENCHMARK("policy inverse loop")
+    {
+        for (size_t i = 0; i != n; ++i)
+        {
+            s[i] = Bessel_Formula::inverse(
+                       Latitude(lat_1[i]), Longitude(lon_1[i]), Latitude(lat_2[i]), Longitude(lon_2[i]), krassovsky)
+                       .s;
+        }
+        return s[n / 2];
+    };
+    BENCHMARK("policy parallel batch inverse")
+    {
+        geodeticInverse<Bessel_Formula>(lat_1, lon_1, lat_2, lon_2, krassovsky, s, forward, backward);
+        return s[n / 2];
+    };
+}
@@ -0,0 +1,133 @@
+#include <algorithm>
+#include <print>
+#include <random>
+#include <vector>
+
+#include <lga/Photogrammetry>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+using namespace Catch::Matchers;
+using namespace lga;
+
+TEST_CASE("bundle adjust")
+{
+    SECTION("two strips")
+    {
+        const Interior interior{.x = 0, .y = 0, .f = 153.24 / 1000, .m = 50000};
+        const double half_frame = 0.115;
+
+        std::vector<Exterior> truth_ex;
+        for (int s = 0; s != 2; ++s)
+        {
+            for (int i = 0; i != 4; ++i)
+            {
+                truth_ex.push_back(Exterior{
+                    .x = 4000.0 * i,
+                    .y = 8000.0 * s,
+                    .z = 7662.0 + 20.0 * i - 10.0 * s,
+                    .phi = 0.002 * (i - 1),
+                    .omega = -0.003 * s + 0.001 * i,
+                    .kappa = 0.01 * s - 0.004 * i});
+            }
+        }
+
+        std::vector<Vector3> truth_pts;
+        for (double x = -5000.0; x <= 17000.0; x += 1000.0)
+        {
+            for (double y = -5000.0; y <= 13000.0; y += 1000.0)
+            {
+                truth_pts.emplace_back(x, y, 100.0 + 0.01 * x - 0.005 * y);
+            }
+        }
+
+        std::mt19937 gen(7);
+        std::normal_distribution<double> noise(0.0, 3e-6);
+        std::vector<Bundle_Observation> obs;
+        std::vector<Vector3> kept;
+        for (const Vector3 &p : truth_pts)
+        {
+            std::vector<Bundle_Observation> seen;
+            for (size_t ii = 0; ii != truth_ex.size(); ++ii)
+            {
+                Vector2 img = obj2img3(p, truth_ex[ii], interior, ex2yxzRotation3(truth_ex[ii]));
+                if (std::abs(img.x()) < half_frame && std::abs(img.y()) < half_frame)
+                {
+                    seen.push_back({ii, kept.size(), img.x() + noise(gen), img.y() + noise(gen)});
+                }
+            }
+            if (seen.size() >= 2)
+            {
+                obs.insert(obs.end(), seen.begin(), seen.end());
+                kept.push_back(p);
+            }
+        }
+
+        Matrix points(kept.size(), 3);
+        for (size_t pi = 0; pi != kept.size(); ++pi)
+        {
+            points.row(pi) = kept[pi].transpose();
+        }
+
+        std::vector<size_t> controls{0, kept.size() / 3, kept.size() / 2, 2 * kept.size() / 3, kept.size() - 1};
+        Matrix initial = points;
+        for (size_t pi = 0; pi != kept.size(); ++pi)
+        {
+            if (std::find(controls.begin(), controls.end(), pi) == controls.end())
+            {
+                initial.row(pi) += Vector3(15.0, -10.0, 25.0).transpose();
+            }
+        }
+
+        std::vector<Image_Meta_Data> images;
+        for (const Exterior &ex : truth_ex)
+        {
+            Exterior guess = ex;
+            guess.x += 30.0;
+            guess.y -= 20.0;
+            guess.z += 40.0;
+            guess.phi = guess.omega = guess.kappa = 0.0;
+            images.push_back({guess, interior});
+        }
+
+        Bundle_Adjustment_Result result = bundleAdjust(images, initial, obs, controls);
+
+        REQUIRE(result.info == Iterative_Algo_Info::SUCCESS);
+        REQUIRE(result.exteriors.size() == truth_ex.size());
+        REQUIRE(result.std_error.rows() == 6 * static_cast<long>(truth_ex.size()));
+        REQUIRE(result.rmse < 1e-5);
+        for (size_t ii = 0; ii != truth_ex.size(); ++ii)
+        {
+            REQUIRE_THAT(result.exteriors[ii].x - truth_ex[ii].x, WithinAbs(0, 1.0));
+            REQUIRE_THAT(result.exteriors[ii].y - truth_ex[ii].y, WithinAbs(0, 1.0));
+            REQUIRE_THAT(result.exteriors[ii].z - truth_ex[ii].z, WithinAbs(0, 1.0));
+            REQUIRE_THAT(result.exteriors[ii].phi - truth_ex[ii].phi, WithinAbs(0, 1e-4));
+            REQUIRE_THAT(result.exteriors[ii].omega - truth_ex[ii].omega, WithinAbs(0, 1e-4));
+            REQUIRE_THAT(result.exteriors[ii].kappa - truth_ex[ii].kappa, WithinAbs(0, 1e-4));
+        }
+        // image noise projected to ground, heights are weaker by base to height ratio of about 1 : 2
+        const double ground_noise = 3e-6 * interior.m;
+        double plane_sq = 0.0, height_sq = 0.0;
+        for (size_t pi = 0; pi != kept.size(); ++pi)
+        {
+            const Vector3 d = (result.points.row(pi) - points.row(pi)).transpose();
+            REQUIRE(d.head<2>().norm() < 6.0 * ground_noise);
+            REQUIRE(std::abs(d.z()) < 10.0 * ground_noise);
+            plane_sq += d.head<2>().squaredNorm();
+            height_sq += d.z() * d.z();
+        }
+        REQUIRE(std::sqrt(plane_sq / (2.0 * kept.size())) < 1.5 * ground_noise);
+        REQUIRE(std::sqrt(height_sq / kept.size()) < 3.0 * ground_noise);
+    }
+
+    SECTION("point observed once")
+    {
+        const Interior interior{.x = 0, .y = 0, .f = 0.15, .m = 50000};
+        std::vector<Image_Meta_Data> images{{Exterior{0, 0, 7500, 0, 0, 0}, interior}};
+        Matrix points = Matrix::Zero(1, 3);
+        std::vector<Bundle_Observation> obs{{0, 0, 0.0, 0.0}};
+        std::vector<size_t> controls;
+        REQUIRE_THROWS_AS(bundleAdjust(images, points, obs, controls), std::invalid_argument);
+    }
+}
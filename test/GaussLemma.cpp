@@ -1,7 +1,9 @@
 #include <print>
+#include <vector>
 #include <iostream>
 
 #include <lga/Geodesy>
+#include <lga/GeodesySolver>
 
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
@@ -30,4 +32,29 @@ TEST_CASE("gauss lemma solve")
         // REQUIRE_THAT(db, WithinAbs(0, 1e-3));
         REQUIRE_THAT(da, WithinAbs(0, 1e-3));
     }
+
+    SECTION("policy batch same as solver facade")
+    {
+        std::vector<double> lat_1, lon_1, lat_2, lon_2;
+        for (int i = 0; i != 50; ++i)
+        {
+            lat_1.push_back(deg2rad(30.0 + 0.5 * i));
+            lon_1.push_back(deg2rad(100.0 + 0.3 * i));
+            lat_2.push_back(deg2rad(30.2 + 0.5 * i));
+            lon_2.push_back(deg2rad(100.1 + 0.3 * i));
+        }
+        const size_t n = lat_1.size();
+        std::vector<double> s(n), forward(n), backward(n), lat(n), lon(n), back(n);
+        geodeticInverse<Gauss_Lemma>(lat_1, lon_1, lat_2, lon_2, cgcs2000, s, forward, backward);
+        geodeticForward<Gauss_Lemma>(lat_1, lon_1, s, forward, cgcs2000, lat, lon, back);
+        for (size_t i = 0; i != n; ++i)
+        {
+            Geodetic_Inverse_Solve_Result ri = gauss_lemma_solve(
+                Latitude(lat_1[i]), Longitude(lon_1[i]), Latitude(lat_2[i]), Longitude(lon_2[i]), cgcs2000);
+            REQUIRE(s[i] == ri.s);
+            REQUIRE(forward[i] == ri.forward.toRadian());
+            REQUIRE(backward[i] == ri.backward.toRadian());
+            REQUIRE_THAT(rad2sec(lon[i] - lon_2[i]), WithinAbs(0, 1e-3));
+        }
+    }
 }
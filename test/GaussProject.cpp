@@ -1,9 +1,11 @@
 #include <print>
 #include <iostream>
+#include <vector>
 
 #include <lga/Geodesy>
 
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
 
 using namespace Catch::Matchers;
@@ -31,4 +33,215 @@ TEST_CASE("gauss project")
             REQUIRE_THAT(rl, WithinAbs(0, 1e-3));
         }
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("batch gauss project")
+{
+    std::vector<double> lat, lon;
+    for (int i = -80; i <= 80; i += 4)
+    {
+        for (int j = 73; j <= 135; j += 2)
+        {
+            lat.push_back(lga::deg2rad(i + 0.37 * (j % 3)));
+            lon.push_back(lga::deg2rad(j + 0.21 * (i % 5)));
+        }
+    }
+    const size_t n = lat.size();
+    std::vector<double> x(n), y(n), lat_inv(n), lon_inv(n);
+    std::vector<int> zones(n);
+
+    SECTION("same as scalar path")
+    {
+        for (double interval : {lga::param::geodesy.gauss_project_interval.three,
+                                lga::param::geodesy.gauss_project_interval.six})
+        {
+            lga::gauss_project.forward(lat, lon, interval, lga::cgcs2000, x, y, zones);
+            lga::gauss_project.inverse(x, y, zones, interval, lga::cgcs2000, lat_inv, lon_inv);
+            for (size_t i = 0; i != n; ++i)
+            {
+                lga::Geodetic_Coordinate gc{lga::Latitude(lat[i]), lga::Longitude(lon[i])};
+                lga::Gauss_Project_Coordinate gpc = lga::gauss_project.forward(gc, interval, lga::cgcs2000);
+                REQUIRE(zones[i] == gpc.zone);
+                REQUIRE_THAT(x[i] - gpc.x, WithinAbs(0, 1e-6));
+                REQUIRE_THAT(y[i] - gpc.y, WithinAbs(0, 1e-6));
+
+                lga::Geodetic_Coordinate gc_inv = lga::gauss_project.inverse(gpc, lga::cgcs2000);
+                REQUIRE_THAT(lga::rad2sec(lat_inv[i] - gc_inv.lat.rad()), WithinAbs(0, 1e-6));
+                REQUIRE_THAT(lga::rad2sec(lon_inv[i] - gc_inv.lon.rad()), WithinAbs(0, 1e-6));
+            }
+        }
+
+        // projected to a neighbour zone
+        lga::gauss_project.forward(lat, lon, 6.0, lga::cgcs2000, x, y, zones, 20);
+        for (size_t i = 0; i < n; i += 7)
+        {
+            lga::Geodetic_Coordinate gc{lga::Latitude(lat[i]), lga::Longitude(lon[i])};
+            lga::Gauss_Project_Coordinate gpc = lga::gauss_project.forward(gc, 6.0, lga::cgcs2000, 20);
+            REQUIRE(zones[i] == 20);
+            REQUIRE_THAT(x[i] - gpc.x, WithinAbs(0, 1e-6));
+            REQUIRE_THAT(y[i] - gpc.y, WithinAbs(0, 1e-6));
+        }
+    }
+
+    SECTION("invalid input")
+    {
+        REQUIRE_THROWS_AS(
+            lga::gauss_project.forward(lat, lon, 4.0, lga::cgcs2000, x, y, zones),
+            std::invalid_argument);
+        REQUIRE_THROWS_AS(
+            lga::gauss_project.forward(lat, std::span(lon).first(n - 1), 6.0, lga::cgcs2000, x, y, zones),
+            std::invalid_argument);
+        REQUIRE_THROWS_AS(
+            lga::gauss_project.inverse(x, y, std::span(zones).first(3), 6.0, lga::cgcs2000, lat_inv, lon_inv),
+            std::invalid_argument);
+        lat[n / 2] = lga::deg2rad(91.0);
+        REQUIRE_THROWS_AS(
+            lga::gauss_project.forward(lat, lon, 6.0, lga::cgcs2000, x, y, zones),
+            std::invalid_argument);
+    }
+}
+
+TEST_CASE("gauss projection context")
+{
+    const lga::Gauss_Projection_Context context(lga::cgcs2000, 6.0, 20);
+    REQUIRE(context.zone() == 20);
+    REQUIRE_THAT(lga::rad2deg(context.centerMeridian().rad()), WithinAbs(117.0, 1e-12));
+
+    std::vector<double> lat, lon;
+    for (int i = 1; i < 80; i += 3)
+    {
+        for (double j : {114.1, 115.5, 117.0, 118.3, 119.9})
+        {
+            lat.push_back(lga::deg2rad(i + 0.25));
+            lon.push_back(lga::deg2rad(j));
+        }
+    }
+    const size_t n = lat.size();
+
+    SECTION("same as scalar path")
+    {
+        for (size_t i = 0; i != n; ++i)
+        {
+            lga::Geodetic_Coordinate gc{lga::Latitude(lat[i]), lga::Longitude(lon[i])};
+            lga::Gauss_Project_Coordinate
+                gpc = lga::gauss_project.forward(gc, 6.0, lga::cgcs2000),
+                gpc_ctx = lga::gauss_project.forward(gc, context);
+            REQUIRE(gpc_ctx.zone == gpc.zone);
+            REQUIRE_THAT(gpc_ctx.x - gpc.x, WithinAbs(0, 1e-6));
+            REQUIRE_THAT(gpc_ctx.y - gpc.y, WithinAbs(0, 1e-6));
+
+            lga::Geodetic_Coordinate
+                gc_inv = lga::gauss_project.inverse(gpc, lga::cgcs2000),
+                gc_inv_ctx = lga::gauss_project.inverse(gpc, context);
+            REQUIRE_THAT(lga::rad2sec(gc_inv_ctx.lat.rad() - gc_inv.lat.rad()), WithinAbs(0, 1e-6));
+            REQUIRE_THAT(lga::rad2sec(gc_inv_ctx.lon.rad() - gc_inv.lon.rad()), WithinAbs(0, 1e-6));
+
+            REQUIRE_THAT(
+                lga::gauss_project.stretch(gc, context) - lga::gauss_project.stretch(gc, 6.0, lga::cgcs2000),
+                WithinAbs(0, 1e-12));
+            REQUIRE_THAT(
+                lga::gauss_project.stretch(gpc, context) - lga::gauss_project.stretch(gpc, lga::cgcs2000),
+                WithinAbs(0, 1e-12));
+            REQUIRE_THAT(
+                lga::gauss_project.meridianConvergence(gc, context).toSeconds() -
+                    lga::gauss_project.meridianConvergence(gc, 6.0, lga::cgcs2000).toSeconds(),
+                WithinAbs(0, 1e-6));
+            REQUIRE_THAT(
+                lga::gauss_project.meridianConvergence(gpc, context).toSeconds() -
+                    lga::gauss_project.meridianConvergence(gpc, 6.0, lga::cgcs2000).toSeconds(),
+                WithinAbs(0, 1e-6));
+
+            if (i != 0)
+            {
+                lga::Gauss_Project_Coordinate prev = lga::gauss_project.forward(
+                    {lga::Latitude(lat[i - 1]), lga::Longitude(lon[i - 1])}, context);
+                lga::Gauss_Project_Direction_Correction
+                    dc = lga::gauss_project.directionCorrection(prev, gpc, lga::cgcs2000),
+                    dc_ctx = lga::gauss_project.directionCorrection(prev, gpc, context);
+                REQUIRE_THAT(dc_ctx.forward.toSeconds() - dc.forward.toSeconds(), WithinAbs(0, 1e-6));
+                REQUIRE_THAT(dc_ctx.backward.toSeconds() - dc.backward.toSeconds(), WithinAbs(0, 1e-6));
+            }
+        }
+
+        std::vector<double> x(n), y(n), x_zone(n), y_zone(n), lat_inv(n), lon_inv(n);
+        std::vector<int> zones(n);
+        lga::gauss_project.forward(lat, lon, context, x, y);
+        lga::gauss_project.forward(lat, lon, 6.0, lga::cgcs2000, x_zone, y_zone, zones, 20);
+        REQUIRE(x == x_zone);
+        REQUIRE(y == y_zone);
+        lga::gauss_project.inverse(x, y, context, lat_inv, lon_inv);
+        for (size_t i = 0; i != n; ++i)
+        {
+            REQUIRE_THAT(lga::rad2sec(lat_inv[i] - lat[i]), WithinAbs(0, 1e-3));
+            REQUIRE_THAT(lga::rad2sec(lon_inv[i] - lon[i]), WithinAbs(0, 1e-3));
+        }
+    }
+
+    SECTION("invalid input")
+    {
+        REQUIRE_THROWS_AS(lga::Gauss_Projection_Context(lga::cgcs2000, 4.0, 20), std::invalid_argument);
+        REQUIRE_THROWS_AS(lga::Gauss_Projection_Context(lga::cgcs2000, 6.0, 61), std::invalid_argument);
+        lga::Gauss_Project_Coordinate other{.interval = 6.0, .x = 3'000'000.0, .y = 1000.0, .zone = 21};
+        REQUIRE_THROWS_AS(lga::gauss_project.inverse(other, context), std::invalid_argument);
+        other.zone = 20;
+        other.interval = 3.0;
+        REQUIRE_THROWS_AS(lga::gauss_project.stretch(other, context), std::invalid_argument);
+    }
+}
+
+TEST_CASE("batch gauss project benchmark", "[.][benchmark]")
+{
+    const size_t n = 100'000;
+    std::vector<double> lat(n), lon(n), x(n), y(n), lat_inv(n), lon_inv(n);
+    std::vector<int> zones(n);
+    for (size_t i = 0; i != n; ++i)
+    {
+        lat[i] = lga::deg2rad(20.0 + 30.0 * i / n);
+        lon[i] = lga::deg2rad(100.0 + (i % 997) * 0.01);
+    }
+
+    BENCHMARK("scalar forward")
+    {
+        double sum = 0.0;
+        for (size_t i = 0; i != n; ++i)
+        {
+            sum += lga::gauss_project.forward(
+                                         {lga::Latitude(lat[i]), lga::Longitude(lon[i])},
+                                         6.0, lga::cgcs2000)
+                       .x;
+        }
+        return sum;
+    };
+    const lga::Gauss_Projection_Context context(lga::cgcs2000, 6.0, 18);
+    BENCHMARK("context forward")
+    {
+        double sum = 0.0;
+        for (size_t i = 0; i != n; ++i)
+        {
+            sum += lga::gauss_project.forward({lga::Latitude(lat[i]), lga::Longitude(lon[i])}, context).x;
+        }
+        return sum;
+    };
+    BENCHMARK("batch forward")
+    {
+        lga::gauss_project.forward(lat, lon, 6.0, lga::cgcs2000, x, y, zones);
+        return x[n / 2];
+    };
+
+    lga::gauss_project.forward(lat, lon, 6.0, lga::cgcs2000, x, y, zones);
+    BENCHMARK("scalar inverse")
+    {
+        double sum = 0.0;
+        for (size_t i = 0; i != n; ++i)
+        {
+            sum += lga::gauss_project.inverse({.interval = 6.0, .x = x[i], .y = y[i], .zone = zones[i]}, lga::cgcs2000)
+                       .lat.rad();
+        }
+        return sum;
+    };
+    BENCHMARK("batch inverse")
+    {
+        lga::gauss_project.inverse(x, y, zones, 6.0, lga::cgcs2000, lat_inv, lon_inv);
+        return lat_inv[n / 2];
+    };
+}
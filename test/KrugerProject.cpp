@@ -0,0 +1,283 @@
+#include <cmath>
+#include <print>
+#include <vector>
+
+#include <lga/Geodesy>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+using namespace Catch::Matchers;
+
+TEST_CASE("kruger project")
+{
+    SECTION("meridian and narrow zone agree with gauss projector")
+    {
+        for (int i = 1; i != 90; ++i)
+        {
+            const lga::Latitude B(lga::deg2rad(i));
+            lga::Gauss_Project_Coordinate gpc = lga::kruger_project(
+                {B, lga::Longitude(lga::deg2rad(117.0))}, 6.0, lga::cgcs2000);
+            REQUIRE(gpc.zone == 20);
+            REQUIRE_THAT(gpc.x - lga::meridianArcLength(B, lga::cgcs2000), WithinAbs(0, 1e-3));
+            REQUIRE_THAT(gpc.y, WithinAbs(0, 1e-9));
+
+            for (double L : {114.0, 115.7, 118.9, 120.0})
+            {
+                lga::Geodetic_Coordinate gc{B, lga::Longitude(lga::deg2rad(L))};
+                lga::Gauss_Project_Coordinate
+                    kruger = lga::kruger_project(gc, 6.0, lga::cgcs2000),
+                    gauss = lga::gauss_project(gc, 6.0, lga::cgcs2000);
+                REQUIRE_THAT(kruger.x - gauss.x, WithinAbs(0, 2e-3));
+                REQUIRE_THAT(kruger.y - gauss.y, WithinAbs(0, 2e-3));
+            }
+        }
+    }
+
+    SECTION("wide zone round trip")
+    {
+        // points up to 30 degrees away from center meridian of zone 20
+        double gauss_error = 0.0;
+        for (int i = 0; i <= 80; i += 5)
+        {
+            for (int j = -30; j <= 30; j += 3)
+            {
+                lga::Geodetic_Coordinate gc{lga::Latitude(lga::deg2rad(i + 0.5)), lga::Longitude(lga::deg2rad(117.0 + j))};
+                lga::Geodetic_Coordinate back = lga::kruger_project(
+                    lga::kruger_project(gc, 6.0, lga::cgcs2000, 20), lga::cgcs2000);
+                REQUIRE_THAT(lga::rad2sec(back.lat.rad() - gc.lat.rad()), WithinAbs(0, 1e-8));
+                REQUIRE_THAT(lga::rad2sec(back.lon.rad() - gc.lon.rad()), WithinAbs(0, 1e-8));
+
+                if (std::abs(j) == 9)
+                {
+                    lga::Geodetic_Coordinate gauss_back = lga::gauss_project(
+                        lga::gauss_project(gc, 6.0, lga::cgcs2000, 20), lga::cgcs2000);
+                    gauss_error = std::max(gauss_error, std::abs(lga::rad2sec(gauss_back.lon.rad() - gc.lon.rad())));
+                }
+            }
+        }
+        // power series of gauss projector is not meant for 9 degrees away from center meridian
+        REQUIRE(gauss_error > 1e-3);
+    }
+
+    SECTION("batch same as scalar path")
+    {
+        std::vector<double> lat, lon;
+        for (int i = -70; i <= 70; i += 7)
+        {
+            for (int j = 100; j <= 130; j += 2)
+            {
+                lat.push_back(lga::deg2rad(i + 0.1));
+                lon.push_back(lga::deg2rad(j + 0.3));
+            }
+        }
+        const size_t n = lat.size();
+        std::vector<double> x(n), y(n), lat_inv(n), lon_inv(n);
+        std::vector<int> zones(n);
+        lga::kruger_project.forward(lat, lon, 3.0, lga::wgs84, x, y, zones);
+        lga::kruger_project.inverse(x, y, zones, 3.0, lga::wgs84, lat_inv, lon_inv);
+        for (size_t i = 0; i != n; ++i)
+        {
+            lga::Gauss_Project_Coordinate gpc =
+                lga::kruger_project({lga::Latitude(lat[i]), lga::Longitude(lon[i])}, 3.0, lga::wgs84);
+            REQUIRE(zones[i] == gpc.zone);
+            REQUIRE(x[i] == gpc.x);
+            REQUIRE(y[i] == gpc.y);
+            REQUIRE_THAT(lga::rad2sec(lat_inv[i] - lat[i]), WithinAbs(0, 1e-8));
+            REQUIRE_THAT(lga::rad2sec(lon_inv[i] - lon[i]), WithinAbs(0, 1e-8));
+        }
+
+        REQUIRE_THROWS_AS(
+            lga::kruger_project.forward(lat, lon, 5.0, lga::wgs84, x, y, zones),
+            std::invalid_argument);
+    }
+
+    SECTION("explicit center meridian")
+    {
+        // 113.5 degrees is no center of a 3 or 6 degree zone, offsets from it match the same offsets in zone 20
+        const lga::Longitude center(lga::deg2rad(113.5));
+        std::vector<double> lat, lon;
+        for (int i = -60; i <= 80; i += 10)
+        {
+            for (int j = -20; j <= 20; j += 4)
+            {
+                lga::Geodetic_Coordinate gc{lga::Latitude(lga::deg2rad(i + 0.5)), lga::Longitude(lga::deg2rad(113.5 + j))};
+                lga::Gauss_Project_Coordinate
+                    local = lga::kruger_project.forward(gc, center, lga::cgcs2000),
+                    zoned = lga::kruger_project(
+                        {gc.lat, lga::Longitude(lga::deg2rad(117.0 + j))}, 6.0, lga::cgcs2000, 20);
+                REQUIRE(local.zone == 0);
+                REQUIRE_THAT(local.x - zoned.x, WithinAbs(0, 1e-6));
+                REQUIRE_THAT(local.y - zoned.y, WithinAbs(0, 1e-6));
+
+                lga::Geodetic_Coordinate back = lga::kruger_project.inverse(local, center, lga::cgcs2000);
+                REQUIRE_THAT(lga::rad2sec(back.lat.rad() - gc.lat.rad()), WithinAbs(0, 1e-8));
+                REQUIRE_THAT(lga::rad2sec(back.lon.rad() - gc.lon.rad()), WithinAbs(0, 1e-8));
+
+                lat.push_back(gc.lat.rad());
+                lon.push_back(gc.lon.rad());
+            }
+        }
+
+        const size_t n = lat.size();
+        std::vector<double> x(n), y(n), lat_inv(n), lon_inv(n);
+        lga::kruger_project.forward(lat, lon, center, lga::cgcs2000, x, y);
+        lga::kruger_project.inverse(x, y, center, lga::cgcs2000, lat_inv, lon_inv);
+        for (size_t i = 0; i != n; ++i)
+        {
+            lga::Gauss_Project_Coordinate gpc =
+                lga::kruger_project.forward({lga::Latitude(lat[i]), lga::Longitude(lon[i])}, center, lga::cgcs2000);
+            REQUIRE(x[i] == gpc.x);
+            REQUIRE(y[i] == gpc.y);
+            REQUIRE_THAT(lga::rad2sec(lat_inv[i] - lat[i]), WithinAbs(0, 1e-8));
+            REQUIRE_THAT(lga::rad2sec(lon_inv[i] - lon[i]), WithinAbs(0, 1e-8));
+        }
+    }
+
+    SECTION("absolute reference at wide offsets")
+    {
+        // PROJ 9.5 `+proj=tmerc +k=1 +ellps=WGS84` around center meridian 117 degrees (zone 20), coordinates agree
+        // with an independent 40-digit evaluation of the exact mapping to a few nanometers. Convergence (deg) and
+        // scale are from `proj_factors`.
+        struct Reference
+        {
+            double lat, l, x, y, gamma, k;
+        };
+        const Reference refs[]{
+            {0.5, 30.0, 63911.440466416425, 3504651.4948129435, 0.2893227688319868, 1.1559857577448596},
+            {20.0, 25.0, 2421924.482011953, 2681846.1784284725, 9.071576938573509, 1.0901845463005473},
+            {40.0, 30.0, 4886256.521874494, 2577965.7362046866, 20.3733110013234, 1.0828351349150218},
+            {60.0, 20.0, 6823572.599735206, 1104331.8377538773, 17.49607525080801, 1.0149720468344492},
+            {75.0, 35.0, 8619555.491030272, 956892.9025433671, 34.07266821837807, 1.0112065268610866},
+            {-35.0, -28.0, -4255443.256334638, -2588877.8894372606, 16.97303439804007, 1.0836628188189037},
+            {10.0, 9.0, 1119448.7294536408, 990614.5653880965, 1.5756697489297202, 1.012162718031284},
+            {45.0, 3.0, 4989325.234792831, 236540.64235815057, 2.122299716731568, 1.0006877730899777}};
+
+        for (const Reference &r : refs)
+        {
+            lga::Geodetic_Coordinate gc{lga::Latitude(lga::deg2rad(r.lat)), lga::Longitude(lga::deg2rad(117.0 + r.l))};
+            lga::Gauss_Project_Coordinate gpc = lga::kruger_project(gc, 6.0, lga::wgs84, 20);
+            REQUIRE_THAT(gpc.x - r.x, WithinAbs(0, 1e-6));
+            REQUIRE_THAT(gpc.y - r.y, WithinAbs(0, 1e-6));
+            REQUIRE_THAT(
+                lga::rad2sec(lga::kruger_project.meridianConvergence(gpc, 6.0, lga::wgs84).toRadian()) - r.gamma * 3600.0,
+                WithinAbs(0, 1e-4));
+            REQUIRE_THAT(lga::kruger_project.stretch(gpc, lga::wgs84) - r.k, WithinAbs(0, 1e-9));
+        }
+
+        // inside zone 20 the geodetic overloads find the same center meridian
+        lga::Geodetic_Coordinate gc{lga::Latitude(lga::deg2rad(45.0)), lga::Longitude(lga::deg2rad(120.0))};
+        REQUIRE_THAT(
+            lga::rad2sec(lga::kruger_project.meridianConvergence(gc, 6.0, lga::wgs84).toRadian()) - refs[7].gamma * 3600.0,
+            WithinAbs(0, 1e-4));
+        REQUIRE_THAT(lga::kruger_project.stretch(gc, 6.0, lga::wgs84) - refs[7].k, WithinAbs(0, 1e-9));
+    }
+
+    SECTION("direction and distance correction")
+    {
+        // geodesics from GeographicLib 2.1 on WGS84, azimuths in deg, 1.5 and 20 degrees from center meridian
+        struct Reference
+        {
+            double lat1, lon1, lat2, lon2, s, azi1, azi2;
+        };
+        const Reference refs[]{
+            {30.0, 118.5, 30.1, 118.62, 16025.237189609845, 46.201820568596354, 46.26191127520492},
+            {40.0, 137.0, 40.1, 137.12, 15104.374405026898, 42.6438860641356, 42.72110081398619}};
+
+        for (const Reference &r : refs)
+        {
+            lga::Geodetic_Coordinate
+                beg{lga::Latitude(lga::deg2rad(r.lat1)), lga::Longitude(lga::deg2rad(r.lon1))},
+                end{lga::Latitude(lga::deg2rad(r.lat2)), lga::Longitude(lga::deg2rad(r.lon2))};
+            lga::Gauss_Project_Coordinate
+                p1 = lga::kruger_project(beg, 6.0, lga::wgs84, 20),
+                p2 = lga::kruger_project(end, 6.0, lga::wgs84, 20);
+
+            // chord direction is grid azimuth of geodesic `A - gamma` plus correction
+            const double
+                chord = std::atan2(p2.y - p1.y, p2.x - p1.x),
+                gamma1 = lga::kruger_project.meridianConvergence(p1, 6.0, lga::wgs84).toRadian(),
+                gamma2 = lga::kruger_project.meridianConvergence(p2, 6.0, lga::wgs84).toRadian();
+            lga::Gauss_Project_Direction_Correction dc = lga::kruger_project.directionCorrection(p1, p2, lga::wgs84);
+            REQUIRE_THAT(
+                lga::rad2sec(chord - (lga::deg2rad(r.azi1) - gamma1 + dc.forward.toRadian())),
+                WithinAbs(0, 1e-4));
+            REQUIRE_THAT(
+                lga::rad2sec(chord - (lga::deg2rad(r.azi2) - gamma2 + dc.backward.toRadian())),
+                WithinAbs(0, 1e-4));
+
+            const double d = lga::kruger_project.distanceCorrection(r.s, beg, end, 6.0, lga::wgs84, 20);
+            REQUIRE_THAT(d - std::hypot(p2.x - p1.x, p2.y - p1.y), WithinAbs(0, 1e-5));
+
+            if (r.lon1 < 120.0)
+            {
+                // power series of gauss projector are good near center meridian
+                lga::Gauss_Project_Direction_Correction gauss = lga::gauss_project.directionCorrection(p1, p2, lga::wgs84);
+                REQUIRE_THAT(lga::rad2sec(gauss.forward.toRadian() - dc.forward.toRadian()), WithinAbs(0, 1e-3));
+                REQUIRE_THAT(lga::rad2sec(gauss.backward.toRadian() - dc.backward.toRadian()), WithinAbs(0, 1e-3));
+                REQUIRE_THAT(lga::gauss_project.distanceCorrection(r.s, beg, end, 6.0, lga::wgs84) - d, WithinAbs(0, 1e-3));
+            }
+        }
+
+        lga::Gauss_Project_Coordinate
+            p1 = lga::kruger_project({lga::Latitude(0.5), lga::Longitude(2.0)}, 6.0, lga::wgs84),
+            p2 = lga::kruger_project.modifyZone(p1, p1.zone + 1, lga::wgs84);
+        REQUIRE(p2.zone == p1.zone + 1);
+        REQUIRE(lga::kruger_project.zoneY(p1) == lga::gauss_project.zoneY(p1));
+        REQUIRE_THROWS_AS(lga::kruger_project.directionCorrection(p1, p2, lga::wgs84), std::invalid_argument);
+
+        lga::Geodetic_Coordinate back = lga::kruger_project(p2, lga::wgs84);
+        REQUIRE_THAT(lga::rad2sec(back.lat.rad() - 0.5), WithinAbs(0, 1e-8));
+        REQUIRE_THAT(lga::rad2sec(back.lon.rad() - 2.0), WithinAbs(0, 1e-8));
+    }
+}
+
+TEST_CASE("kruger project benchmark", "[.][benchmark]")
+{
+    const size_t n = 100'000;
+    std::vector<double> lat(n), lon(n), x(n), y(n), lat_inv(n), lon_inv(n);
+    std::vector<int> zones(n);
+    for (size_t i = 0; i != n; ++i)
+    {
+        lat[i] = lga::deg2rad(20.0 + 30.0 * i / n);
+        lon[i] = lga::deg2rad(100.0 + (i % 997) * 0.01);
+    }
+
+    // round trip error of both engines at 3 and 12 degrees from center meridian
+    for (double offset : {3.0, 12.0})
+    {
+        lga::Geodetic_Coordinate gc{lga::Latitude(lga::deg2rad(35.0)), lga::Longitude(lga::deg2rad(105.0 + offset))};
+        lga::Geodetic_Coordinate
+            gauss = lga::gauss_project(lga::gauss_project(gc, 6.0, lga::cgcs2000, 18), lga::cgcs2000),
+            kruger = lga::kruger_project(lga::kruger_project(gc, 6.0, lga::cgcs2000, 18), lga::cgcs2000);
+        std::println(
+            "{:.0f} deg from center meridian, longitude round trip error: gauss {:.3e}\", kruger {:.3e}\"",
+            offset,
+            lga::rad2sec(gauss.lon.rad() - gc.lon.rad()),
+            lga::rad2sec(kruger.lon.rad() - gc.lon.rad()));
+    }
+
+    BENCHMARK("gauss batch forward")
+    {
+        lga::gauss_project.forward(lat, lon, 6.0, lga::cgcs2000, x, y, zones);
+        return x[n / 2];
+    };
+    BENCHMARK("kruger batch forward")
+    {
+        lga::kruger_project.forward(lat, lon, 6.0, lga::cgcs2000, x, y, zones);
+        return x[n / 2];
+    };
+
+    lga::kruger_project.forward(lat, lon, 6.0, lga::cgcs2000, x, y, zones);
+    BENCHMARK("gauss batch inverse")
+    {
+        lga::gauss_project.inverse(x, y, zones, 6.0, lga::cgcs2000, lat_inv, lon_inv);
+        return lat_inv[n / 2];
+    };
+    BENCHMARK("kruger batch inverse")
+    {
+        lga::kruger_project.inverse(x, y, zones, 6.0, lga::cgcs2000, lat_inv, lon_inv);
+        return lat_inv[n / 2];
+    };
+}
@@ -0,0 +1,171 @@
+#include <cmath>
+#include <print>
+#include <vector>
+#include <algorithm>
+
+#include <lga/Photogrammetry>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+using namespace Catch::Matchers;
+using namespace lga;
+
+TEST_CASE("lens distortion")
+{
+    const double half_frame = 0.115;
+    const Lens_Distortion distortion{.k1 = 0.05, .k2 = -1.0, .k3 = 5.0, .p1 = 2e-4, .p2 = -1e-4};
+
+    SECTION("grid lookup inverts distortion")
+    {
+        REQUIRE(Lens_Distortion{}.isZero());
+        REQUIRE(!distortion.isZero());
+
+        Matrix ideal = Matrix::Random(5000, 2) * half_frame;
+        Matrix observed = distort(ideal, distortion);
+        for (int r = 0; r < ideal.rows(); r += 101)
+        {
+            REQUIRE(distort3(ideal.row(r).transpose(), distortion).isApprox(observed.row(r).transpose(), 1e-15));
+        }
+        REQUIRE((observed - ideal).cwiseAbs().maxCoeff() > 1e-5);
+
+        Undistortion_Grid grid(distortion, half_frame, half_frame);
+        REQUIRE(grid.maxError() < 1e-7);
+        Matrix back = grid.undistort(observed);
+        REQUIRE((back - ideal).cwiseAbs().maxCoeff() < 2e-7);
+
+        // extrapolated slightly outside the frame
+        Vector2 corner = distort3(Vector2(0.118, -0.118), distortion);
+        REQUIRE((grid.undistort3(corner) - Vector2(0.118, -0.118)).norm() < 1e-6);
+
+        Undistortion_Grid identity(Lens_Distortion{}, half_frame, half_frame, 4, 4);
+        REQUIRE(identity.undistort(ideal).isApprox(ideal, 1e-15));
+
+        REQUIRE_THROWS_AS(Undistortion_Grid(distortion, 0.0, half_frame), std::invalid_argument);
+        REQUIRE_THROWS_AS(grid.undistort(Matrix(3, 3)), Matrix_Shape_Error);
+    }
+
+    SECTION("interior applies distortion in every conversion")
+    {
+        const Interior ideal{.x = 0, .y = 0, .f = 153.24 / 1000, .m = 50000};
+        Interior lens = ideal;
+        {
+            // copies share the grid, it lives as long as any of them
+            Interior scoped = ideal;
+            scoped.undistortion = std::make_shared<const Undistortion_Grid>(
+                distortion, half_frame, half_frame, 128, 128);
+            lens = scoped;
+        }
+        REQUIRE(lens.undistortion->distortion().k3 == distortion.k3);
+        std::vector<Exterior> exteriors{
+            {0.0, 0.0, 7662.0, 0.002, -0.001, 0.01},
+            {4000.0, 50.0, 7680.0, -0.001, 0.002, 0.005}};
+
+        const int n = 25;
+        Matrix truth(n, 3);
+        for (int r = 0; r != n; ++r)
+        {
+            truth.row(r) << 500.0 + 750.0 * (r % 5), -1500.0 + 750.0 * (r / 5), 100.0 + 40.0 * (r % 3);
+        }
+
+        // projections come out as observed coordinates
+        std::vector<Matrix> observed;
+        std::vector<Oriented_Image> images;
+        for (const Exterior &ex : exteriors)
+        {
+            observed.push_back(obj2img(truth, ex, lens));
+            images.emplace_back(Image_Meta_Data{ex, lens});
+            const Matrix &img = observed.back();
+            REQUIRE((img - distort(obj2img(truth, ex, ideal), distortion)).cwiseAbs().maxCoeff() < 1e-15);
+            REQUIRE((obj2img(truth, images.back()) - img).cwiseAbs().maxCoeff() < 1e-15);
+            for (int r = 0; r != n; ++r)
+            {
+                REQUIRE((images.back().obj2img(truth.row(r).transpose()) - img.row(r).transpose()).norm() < 1e-15);
+                REQUIRE((obj2img3(truth.row(r).transpose(), ex, lens, images.back().rotate()) -
+                         img.row(r).transpose())
+                            .norm() < 1e-15);
+            }
+        }
+
+        std::vector<Space_Intersection_Ols_Block> blocks;
+        std::vector<Space_Resection_Job> jobs;
+        std::vector<Bundle_Observation> observations;
+        for (size_t i = 0; i != exteriors.size(); ++i)
+        {
+            blocks.push_back({.meta = {exteriors[i], lens}, .image = observed[i]});
+            jobs.push_back({.interior = lens, .image = observed[i], .object = truth});
+            for (int r = 0; r != n; ++r)
+            {
+                observations.push_back({i, static_cast<size_t>(r), observed[i](r, 0), observed[i](r, 1)});
+            }
+        }
+
+        // resection
+        std::vector<Space_Resection_Result> resections = batchSpaceResection(jobs);
+        resections.push_back(spaceResection(lens, observed[1], truth));
+        resections.push_back(robustSpaceResection(lens, observed[1], truth).resection);
+        for (size_t i = 0; i != resections.size(); ++i)
+        {
+            const Exterior &ex = exteriors[std::min(i, exteriors.size() - 1)];
+            REQUIRE(resections[i].info == Iterative_Algo_Info::SUCCESS);
+            REQUIRE_THAT(resections[i].exterior.x - ex.x, WithinAbs(0, 1e-1));
+            REQUIRE_THAT(resections[i].exterior.z - ex.z, WithinAbs(0, 1e-1));
+            REQUIRE_THAT(resections[i].exterior.kappa - ex.kappa, WithinAbs(0, 1e-5));
+        }
+
+        // intersection
+        Matrix pair = spaceIntersection({exteriors[0], lens}, observed[0], {exteriors[1], lens}, observed[1]);
+        Space_Intersection_Ols_Result ols = spaceIntersection(blocks);
+        Space_Intersection_Batch_Result batch = batchSpaceIntersection(blocks);
+        std::vector<Track_Observation> tracks;
+        std::vector<size_t> offsets{0};
+        for (int r = 0; r != n; ++r)
+        {
+            for (size_t i = 0; i != images.size(); ++i)
+            {
+                tracks.push_back({i, observed[i](r, 0), observed[i](r, 1)});
+            }
+            offsets.push_back(tracks.size());
+        }
+        Space_Intersection_Batch_Result triangulated = triangulateTracks(images, tracks, offsets);
+        REQUIRE(ols.info == Iterative_Algo_Info::SUCCESS);
+        REQUIRE(batch.info == Iterative_Algo_Info::SUCCESS);
+        REQUIRE(triangulated.info == Iterative_Algo_Info::SUCCESS);
+        for (int r = 0; r != n; ++r)
+        {
+            REQUIRE((pair.row(r) - truth.row(r)).norm() < 1e-1);
+            REQUIRE((ols.coordinate.row(r) - truth.row(r)).norm() < 1e-1);
+            REQUIRE((batch.coordinate.row(r) - truth.row(r)).norm() < 1e-1);
+            REQUIRE((triangulated.coordinate.row(r) - truth.row(r)).norm() < 1e-1);
+        }
+
+        // bundle adjustment from perturbed exteriors with all points held fixed
+        std::vector<Image_Meta_Data> metas;
+        for (const Exterior &ex : exteriors)
+        {
+            Exterior start = ex;
+            start.x += 5.0;
+            start.kappa -= 1e-3;
+            metas.push_back({start, lens});
+        }
+        std::vector<size_t> controls(n);
+        for (int r = 0; r != n; ++r)
+        {
+            controls[r] = r;
+        }
+        Bundle_Adjustment_Result bundle = bundleAdjust(metas, truth, observations, controls);
+        REQUIRE(bundle.info == Iterative_Algo_Info::SUCCESS);
+        for (size_t i = 0; i != exteriors.size(); ++i)
+        {
+            REQUIRE_THAT(bundle.exteriors[i].x - exteriors[i].x, WithinAbs(0, 1e-1));
+            REQUIRE_THAT(bundle.exteriors[i].kappa - exteriors[i].kappa, WithinAbs(0, 1e-5));
+        }
+
+        // ignoring distortion leaves metre level errors
+        blocks[0].meta.interior = blocks[1].meta.interior = ideal;
+        Space_Intersection_Batch_Result raw = batchSpaceIntersection(blocks);
+        REQUIRE((raw.coordinate - truth).rowwise().norm().maxCoeff() > 1.0);
+        Space_Resection_Result raw_resection = spaceResection(ideal, observed[1], truth);
+        REQUIRE(raw_resection.rmse > 100 * resections[2].rmse);
+    }
+}
@@ -0,0 +1,106 @@
+#include <print>
+#include <iostream>
+
+#include <lga/Linalg>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+using namespace Catch::Matchers;
+using namespace lga;
+
+TEST_CASE("linalg")
+{
+    SECTION("diagonal weight equals dense weight")
+    {
+        const int n = 20, t = 4;
+        Matrix A = Matrix::Random(n, t), L = Matrix::Random(n, 1);
+        lga::Vector w = lga::Vector::Random(n).cwiseAbs().array() + 0.5;
+        Matrix P = w.asDiagonal();
+        Diagonal_Matrix D(w);
+
+        Matrix N_dense = normalizedEquation(A, P),
+               N_vec = normalizedEquation(A, w),
+               N_diag = normalizedEquation(A, D);
+        REQUIRE(N_dense.isApprox(N_vec, 1e-12));
+        REQUIRE(N_dense.isApprox(N_diag, 1e-12));
+
+        Matrix x_dense = ols(A, L, P),
+               x_vec = ols(A, L, w),
+               x_diag = ols(A, L, D);
+        REQUIRE(x_dense.isApprox(x_vec, 1e-12));
+        REQUIRE(x_dense.isApprox(x_diag, 1e-12));
+
+        Matrix V = A * x_dense - L;
+        REQUIRE_THAT(rmse(V, n, t, P) - rmse(V, n, t, w), WithinAbs(0, 1e-12));
+        REQUIRE_THAT(rmse(V, n, t, P) - rmse(V, n, t, D), WithinAbs(0, 1e-12));
+    }
+
+    SECTION("normal equation solver equals explicit inverse")
+    {
+        const int n = 30, t = 6;
+        Matrix A = Matrix::Random(n, t), L = Matrix::Random(n, 1);
+        Matrix N = normalizedEquation(A);
+        Matrix N_inv = choleskyInverse(N);
+
+        Normal_Equation_Solver solver(N);
+        REQUIRE(solver.size() == t);
+        REQUIRE(solver.solve(A.transpose() * L).isApprox(N_inv * A.transpose() * L, 1e-10));
+        REQUIRE(solver.cofactorDiagonal().isApprox(N_inv.diagonal(), 1e-10));
+        REQUIRE(solver.cofactorBlock(3, 3, 3, 3).isApprox(N_inv.block(3, 3, 3, 3), 1e-10));
+        REQUIRE_THAT(solver.cofactorBlock(1, 4)(0, 0) - N_inv(1, 4), WithinAbs(0, 1e-10));
+
+        // indefinite matrix falls back to LDLT
+        Matrix S = Matrix::Random(t, t);
+        S = (S + S.transpose()).eval();
+        S.diagonal().array() += 0.1;
+        Normal_Equation_Solver ldlt(S);
+        Matrix S_inv = S.inverse();
+        REQUIRE(ldlt.cofactorDiagonal().isApprox(S_inv.diagonal(), 1e-8));
+        REQUIRE(ldlt.cofactorBlock(0, 0, t, t).isApprox(S_inv, 1e-8));
+    }
+
+    SECTION("fixed-size rotation equals dynamic rotation")
+    {
+        const double x = 0.12, y = -0.34, z = 1.56;
+        REQUIRE(Matrix(xRotation3(x)).isApprox(xRotation(x)));
+        REQUIRE(Matrix(yRotation3(y)).isApprox(yRotation(y)));
+        REQUIRE(Matrix(zRotation3(z)).isApprox(zRotation(z)));
+        REQUIRE(Matrix(rotationMatrix3(x, y, z)).isApprox(rotationMatrix(x, y, z)));
+        REQUIRE((rotationMatrix3(x, y, z) * rotationMatrix3(x, y, z).transpose()).isIdentity(1e-12));
+    }
+
+    SECTION("batched transform equals reference transform")
+    {
+        const int n = 10000;
+        const double x = 12.5, y = -3.25, z = 100.0, s = 1.0002;
+        Matrix coord = Matrix::Random(n, 3) * 1000.0;
+        Matrix R = rotationMatrix(0.12, -0.34, 1.56);
+
+        Matrix out;
+        translate(coord, out, x, y, z);
+        REQUIRE(out.isApprox(translate(coord, x, y, z), 1e-14));
+        rotateForward(coord, out, rotationMatrix3(0.12, -0.34, 1.56));
+        REQUIRE(out.isApprox(coord * R, 1e-12));
+        rotateInverse(coord, out, rotationMatrix3(0.12, -0.34, 1.56));
+        REQUIRE(out.isApprox(coord * R.transpose(), 1e-12));
+        scale(coord, out, s);
+        REQUIRE(out.isApprox(coord * s, 1e-14));
+
+        Matrix ref = scale(rotateForward(translate(coord, x, y, z), R), s);
+        Similarity_Transform_Param param{x, y, z, rotationMatrix3(0.12, -0.34, 1.56), s};
+        REQUIRE(similarityTransform(coord, param).isApprox(ref, 1e-12));
+
+        Matrix in_place = coord;
+        translateInPlace(in_place, x, y, z);
+        rotateForwardInPlace(in_place, rotationMatrix3(0.12, -0.34, 1.56));
+        scaleInPlace(in_place, s);
+        REQUIRE(in_place.isApprox(ref, 1e-12));
+
+        in_place = coord;
+        similarityTransformInPlace(in_place, param);
+        REQUIRE(in_place.isApprox(ref, 1e-12));
+        rotateInverseInPlace(in_place, rotationMatrix3(0.12, -0.34, 1.56));
+        REQUIRE(in_place.isApprox(translate(coord, x, y, z) * s, 1e-12));
+    }
+}
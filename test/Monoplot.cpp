@@ -0,0 +1,87 @@
+#include <cmath>
+#include <print>
+#include <random>
+#include <vector>
+
+#include <lga/Photogrammetry>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+using namespace Catch::Matchers;
+using namespace lga;
+
+TEST_CASE("monoplot")
+{
+    const size_t side = 501;
+    const Raster_Geometry geometry{.x = 0.0, .y = 5010.0, .gsd = 10.0, .cols = side, .rows = side};
+    std::vector<float> heights(side * side);
+    for (size_t r = 0; r != side; ++r)
+    {
+        for (size_t c = 0; c != side; ++c)
+        {
+            const double x = (c + 0.5) * 10.0, y = 5010.0 - (r + 0.5) * 10.0;
+            heights[r * side + c] = static_cast<float>(100.0 + 30.0 * std::sin(x / 300.0) * std::cos(y / 200.0));
+        }
+    }
+    const Dem_Raster dem{.geometry = geometry, .height = heights};
+    const Dem_Height_Pyramid pyramid(dem);
+    REQUIRE(pyramid.levels() == 10);
+
+    const Interior interior{.x = 0, .y = 0, .f = 0.15, .m = 13000};
+    const Exterior exterior{2500.0, 2500.0, 2100.0, 0.01, -0.015, 0.4};
+    const Matrix3 rotate = ex2yxzRotation3(exterior);
+
+    SECTION("rays hit terrain at projected ground points")
+    {
+        // ground points on cell centers, where dem height is exact
+        std::mt19937 gen(3);
+        std::uniform_int_distribution<size_t> cell(170, 330);
+        const int n = 5000;
+        Matrix ground(n, 3), img(n, 2);
+        for (int pi = 0; pi != n; ++pi)
+        {
+            const size_t r = cell(gen), c = cell(gen);
+            ground.row(pi) << (c + 0.5) * 10.0, 5010.0 - (r + 0.5) * 10.0, heights[r * side + c];
+            img.row(pi) = obj2img3(ground.row(pi).transpose(), exterior, interior, rotate).transpose();
+        }
+
+        Monoplot_Result result = monoplot({exterior, interior}, img, pyramid);
+        for (int pi = 0; pi != n; ++pi)
+        {
+            REQUIRE(result.hit[pi]);
+            REQUIRE((result.coordinate.row(pi) - ground.row(pi)).norm() < 1e-3);
+        }
+
+        // through lens distortion and undistortion grid
+        const Lens_Distortion distortion{.k1 = 0.05, .k2 = -1.0};
+        Interior lens = interior;
+        lens.undistortion = std::make_shared<const Undistortion_Grid>(distortion, 0.115, 0.115, 128, 128);
+        Monoplot_Result distorted = monoplot({exterior, lens}, distort(img, distortion), pyramid);
+        for (int pi = 0; pi != n; ++pi)
+        {
+            REQUIRE(distorted.hit[pi]);
+            REQUIRE((distorted.coordinate.row(pi) - ground.row(pi)).norm() < 0.1);
+        }
+    }
+
+    SECTION("rays leaving dem miss")
+    {
+        Matrix img(2, 2);
+        img << 0.9, 0.0,
+            0.0, 0.0;
+        Monoplot_Result result = monoplot({exterior, interior}, img, pyramid);
+        REQUIRE(!result.hit[0]);
+        REQUIRE(std::isnan(result.coordinate(0, 2)));
+        REQUIRE(result.hit[1]);
+
+        Vector3 ground;
+        REQUIRE(!pyramid.intersect(Vector3(2500.0, 2500.0, 2100.0), Vector3(0.0, 0.0, 1.0), ground));
+        REQUIRE(pyramid.intersect(Vector3(2500.0, 2500.0, 2100.0), Vector3(0.0, 0.0, -1.0), ground));
+        REQUIRE_THAT(ground.z(), WithinAbs(100.0, 30.0));
+
+        const Dem_Raster thin{.geometry = {0.0, 10.0, 10.0, side, 1}, .height = std::span(heights).first(side)};
+        REQUIRE_THROWS_AS(Dem_Height_Pyramid(thin), std::invalid_argument);
+        REQUIRE_THROWS_AS(monoplot({exterior, interior}, Matrix(2, 3), pyramid), Matrix_Shape_Error);
+    }
+}
@@ -0,0 +1,117 @@
+#include <cmath>
+#include <cstdint>
+#include <print>
+#include <vector>
+
+#include <lga/Photogrammetry>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+using namespace Catch::Matchers;
+using namespace lga;
+
+TEST_CASE("orthorectify")
+{
+    const Interior interior{.x = 0, .y = 0, .f = 0.15, .m = 10000};
+    const Exterior exterior{5000.0, 5000.0, 1600.0, 0.01, -0.02, 0.3};
+    const Matrix3 rotate = ex2yxzRotation3(exterior);
+    auto terrain = [](double x, [[maybe_unused]] double y)
+    { return 100.0 + 0.01 * (x - 5000.0); };
+    auto texture = [](double x, double y)
+    { return 128.0 + 100.0 * std::sin(x / 60.0) * std::cos(y / 80.0); };
+
+    // render image by intersecting every pixel ray with the terrain plane
+    const size_t cols = 1000, rows = 1000, channels = 2;
+    const double pixel = 0.23 / cols;
+    std::vector<std::uint8_t> pixels(cols * rows * channels);
+    for (size_t r = 0; r != rows; ++r)
+    {
+        for (size_t c = 0; c != cols; ++c)
+        {
+            const Vector3 aux = isp2aux3(
+                Vector3((c + 0.5 - cols / 2.0) * pixel, (rows / 2.0 - r - 0.5) * pixel, -interior.f), rotate);
+            const double t =
+                (100.0 + 0.01 * (exterior.x - 5000.0) - exterior.z) / (aux.z() - 0.01 * aux.x());
+            const double value = texture(exterior.x + t * aux.x(), exterior.y + t * aux.y());
+            pixels[(r * cols + c) * channels] = static_cast<std::uint8_t>(value + 0.5);
+            pixels[(r * cols + c) * channels + 1] = static_cast<std::uint8_t>(255.0 - value + 0.5);
+        }
+    }
+    const Image_Raster image{.data = pixels, .cols = cols, .rows = rows, .channels = channels, .pixel_size = pixel};
+
+    std::vector<float> heights(11 * 11);
+    const Raster_Geometry dem_geometry{.x = 4000.0, .y = 6000.0, .gsd = 200.0, .cols = 11, .rows = 11};
+    for (size_t r = 0; r != 11; ++r)
+    {
+        for (size_t c = 0; c != 11; ++c)
+        {
+            heights[r * 11 + c] = terrain(4000.0 + (c + 0.5) * 200.0, 6000.0 - (r + 0.5) * 200.0);
+        }
+    }
+    const Dem_Raster dem{.geometry = dem_geometry, .height = heights};
+
+    SECTION("indirect method reproduces texture")
+    {
+        const Raster_Geometry ortho{.x = 4200.0, .y = 5800.0, .gsd = 2.0, .cols = 1100, .rows = 800};
+        std::vector<std::uint8_t> out(ortho.cols * ortho.rows * channels);
+        orthorectify({exterior, interior}, dem, image, ortho, out);
+
+        size_t checked = 0;
+        for (size_t r = 0; r != ortho.rows; ++r)
+        {
+            for (size_t c = 0; c != ortho.cols; ++c)
+            {
+                const double
+                    x = ortho.x + (c + 0.5) * ortho.gsd,
+                    y = ortho.y - (r + 0.5) * ortho.gsd;
+                const std::uint8_t *cell = &out[(r * ortho.cols + c) * channels];
+                if (x > 6200.0)
+                {
+                    // outside of dem
+                    REQUIRE(cell[0] == 0);
+                    REQUIRE(cell[1] == 0);
+                }
+                else if (x < 5800.0)
+                {
+                    REQUIRE_THAT(cell[0] - texture(x, y), WithinAbs(0, 2.5));
+                    REQUIRE(static_cast<int>(cell[0]) + cell[1] >= 254);
+                    REQUIRE(static_cast<int>(cell[0]) + cell[1] <= 256);
+                    ++checked;
+                }
+            }
+        }
+        REQUIRE(checked > 600000);
+    }
+
+    SECTION("bands are streamed in order")
+    {
+        const Raster_Geometry ortho{.x = 4500.0, .y = 5500.0, .gsd = 5.0, .cols = 200, .rows = 170};
+        std::vector<std::uint8_t> whole(ortho.cols * ortho.rows * channels), streamed;
+        orthorectify({exterior, interior}, dem, image, ortho, whole, {.tile = 64});
+
+        std::vector<std::uint8_t> oriented(whole.size());
+        orthorectify(Oriented_Image(Image_Meta_Data{exterior, interior}), dem, image, ortho, oriented, {.tile = 64});
+        REQUIRE(oriented == whole);
+
+        size_t next = 0;
+        orthorectify(
+            {exterior, interior}, dem, image, ortho,
+            [&](size_t p_first_row, size_t p_rows, std::span<const std::uint8_t> p_band)
+            {
+                REQUIRE(p_first_row == next);
+                REQUIRE(p_rows <= 64);
+                REQUIRE(p_band.size() == p_rows * ortho.cols * channels);
+                streamed.insert(streamed.end(), p_band.begin(), p_band.end());
+                next += p_rows;
+            },
+            {.tile = 64});
+        REQUIRE(next == ortho.rows);
+        REQUIRE(streamed == whole);
+
+        std::vector<std::uint8_t> small(10);
+        REQUIRE_THROWS_AS(orthorectify({exterior, interior}, dem, image, ortho, small), std::invalid_argument);
+        const Dem_Raster broken{.geometry = dem_geometry, .height = std::span(heights).first(10)};
+        REQUIRE_THROWS_AS(orthorectify({exterior, interior}, broken, image, ortho, whole), std::invalid_argument);
+    }
+}
@@ -1,4 +1,5 @@
 #include <print>
+#include <limits>
 #include <iostream>
 
 #include <lga/Photogrammetry>
@@ -79,6 +80,31 @@ TEST_CASE("space intersection")
         };
         auto result =
             spaceIntersection(params);
+        auto damped =
+            spaceIntersection(params, 50, 1e-5, cceSimplifyNone, {}, {.method = Iterative_Step_Method::LEVENBERG_MARQUARDT});
+        REQUIRE(result.telemetry.rmse.size() == result.iterations);
+        REQUIRE(damped.telemetry.rmse.size() == damped.iterations);
+        REQUIRE(damped.coordinate.isApprox(result.coordinate, 1e-8));
+
+        auto inverted = spaceIntersection(params, 50, 1e-5, cceSimplifyNone, choleskyInverse);
+        for (const auto &r : {result, inverted})
+        {
+            REQUIRE(r.sigma.rows() == 3);
+            REQUIRE(r.sigma.cols() == 3);
+            REQUIRE(r.std_error.rows() == 3);
+            REQUIRE(r.std_error.isApprox(r.sigma.diagonal()));
+        }
+        REQUIRE(result.std_error.isApprox(inverted.std_error, 1e-8));
+
+        std::vector<Space_Intersection_Ols_Block> bad = params;
+        bad[0].image(2, 0) = std::numeric_limits<double>::quiet_NaN();
+        auto stalled =
+            spaceIntersection(bad, 50, 1e-5, cceSimplifyNone, {}, {.method = Iterative_Step_Method::LEVENBERG_MARQUARDT});
+        REQUIRE(stalled.info == Iterative_Algo_Info::NOT_CONVERGED);
+        // stalled point is retried with raised damping until iterations run out
+        REQUIRE(stalled.iterations == 50);
+        REQUIRE(stalled.telemetry.lambda.back() > stalled.telemetry.lambda.front());
+        REQUIRE(stalled.coordinate.row(0).isApprox(damped.coordinate.row(0), 1e-8));
         Matrix img_left_inv = obj2img(result.coordinate, ex_left, in_left);
         Matrix img_right_inv = obj2img(result.coordinate, ex_right, in_right);
         Matrix img_inv(5, 4);
@@ -93,4 +119,92 @@ TEST_CASE("space intersection")
             }
         }
     }
-}
\ No newline at end of file
+
+    SECTION("batch")
+    {
+        const Interior interior{.x = 0, .y = 0, .f = 153.24 / 1000, .m = 50000};
+        std::vector<Exterior> exteriors{
+            {0.0, 0.0, 7662.0, 0.002, -0.001, 0.01},
+            {4000.0, 50.0, 7680.0, -0.001, 0.002, 0.005},
+            {8000.0, -30.0, 7650.0, 0.0, 0.001, -0.004},
+            {4000.0, 5000.0, 7670.0, 0.001, 0.0, 0.02}};
+
+        const int n = 2000;
+        Matrix truth(n, 3);
+        for (int r = 0; r != n; ++r)
+        {
+            truth.row(r) << 3000.0 + 2.0 * (r % 50) * 20.0, 1000.0 + (r / 50) * 50.0, 100.0 + 3.0 * (r % 7);
+        }
+
+        std::vector<Space_Intersection_Ols_Block> blocks;
+        for (const Exterior &ex : exteriors)
+        {
+            blocks.push_back({.meta = {ex, interior}, .image = obj2img(truth, ex, interior)});
+        }
+
+        Space_Intersection_Batch_Result result = batchSpaceIntersection(blocks);
+        REQUIRE(result.info == Iterative_Algo_Info::SUCCESS);
+        REQUIRE(result.std_error.rows() == n);
+        for (int r = 0; r != n; ++r)
+        {
+            for (int c = 0; c != 3; ++c)
+            {
+                REQUIRE_THAT(result.coordinate(r, c) - truth(r, c), WithinAbs(0, 1e-4));
+            }
+        }
+
+        Space_Intersection_Ols_Result sequential = spaceIntersection(std::span(blocks).first(3));
+        Space_Intersection_Batch_Result batch = batchSpaceIntersection(std::span(blocks).first(3));
+        REQUIRE(sequential.coordinate.isApprox(batch.coordinate, 1e-9));
+
+        std::vector<Space_Intersection_Oriented_Block> oriented;
+        for (const Space_Intersection_Ols_Block &block : std::span(blocks).first(3))
+        {
+            oriented.push_back({.oriented = Oriented_Image(block.meta), .image = block.image});
+        }
+        REQUIRE(spaceIntersection(oriented).coordinate.isApprox(sequential.coordinate, 1e-15));
+        REQUIRE(batchSpaceIntersection(oriented).coordinate.isApprox(batch.coordinate, 1e-15));
+        REQUIRE_THROWS_AS(spaceIntersection(std::span(oriented).first(1)), std::invalid_argument);
+
+        blocks[2].image = blocks[2].image.topRows(10);
+        REQUIRE_THROWS_AS(batchSpaceIntersection(blocks), Matrix_Shape_Error);
+    }
+
+    SECTION("oriented image")
+    {
+        const Interior interior{.f = 150.0 / 1000.0, .m = 50000};
+        const Exterior
+            ex_left{4999.770168, 4999.728897, 2000.002353, 0.00021500, 0.02906441, 0.09524706},
+            ex_right{5896.828551, 5070.244316, 2030.443250, 0.01443355, 0.04601826, 0.11046904};
+        const Oriented_Image left(Image_Meta_Data{ex_left, interior}), right(Image_Meta_Data{ex_right, interior});
+        REQUIRE(left.rotate().isApprox(ex2yxzRotation3(ex_left), 1e-15));
+        REQUIRE((left.rotate() * left.rotateTranspose()).isIdentity(1e-15));
+
+        Matrix obj(3, 3);
+        obj << 5083.205, 5852.099, 527.925,
+            5780.02, 5906.365, 571.549,
+            5210.879, 4258.446, 461.81;
+        Matrix aux = obj2aux(obj, left);
+        REQUIRE(aux.isApprox(obj2aux(obj, ex_left), 1e-15));
+        REQUIRE(aux2obj(aux, left).isApprox(obj, 1e-15));
+        REQUIRE(aux2obj(aux, ex_left).isApprox(obj, 1e-15));
+        Matrix isp = aux2isp(aux, left);
+        REQUIRE(isp.isApprox(aux2isp(aux, ex_left), 1e-15));
+        REQUIRE(isp2aux(isp, left).isApprox(isp2aux(isp, ex_left), 1e-15));
+
+        Matrix img_left = obj2img(obj, left), img_right = obj2img(obj, right);
+        REQUIRE(img_left.isApprox(obj2img(obj, ex_left, interior), 1e-15));
+        for (int r = 0; r != 3; ++r)
+        {
+            const Vector3 point = obj.row(r).transpose();
+            REQUIRE(left.obj2isp(point).isApprox(isp.row(r).transpose(), 1e-12));
+            REQUIRE(left.obj2img(point).isApprox(img_left.row(r).transpose(), 1e-12));
+            // ray through image point passes through object point
+            REQUIRE(left.img2aux(left.obj2img(point)).normalized().isApprox((point - left.center()).normalized(), 1e-12));
+        }
+
+        Matrix result = spaceIntersection(left, img_left, right, img_right);
+        REQUIRE(result.isApprox(spaceIntersection(left.meta(), img_left, right.meta(), img_right), 1e-15));
+        REQUIRE(result.isApprox(obj, 1e-9));
+    }
+}
@@ -1,5 +1,7 @@
 #include <sstream>
+#include <vector>
 #include <print>
+#include <limits>
 
 #include <lga/Photogrammetry>
 
@@ -33,6 +35,18 @@ TEST_CASE("space resection")
 
         REQUIRE(result.info == Iterative_Algo_Info::SUCCESS);
 
+        // full error matrix and its diagonal whether cofactors come from factorization or explicit inverse
+        Space_Resection_Result inverted =
+            spaceResection(interior, img, obj, 50, 1e-5, cceSimplifyNone, choleskyInverse);
+        for (const Space_Resection_Result &r : {result, inverted})
+        {
+            REQUIRE(r.sigma.rows() == 6);
+            REQUIRE(r.sigma.cols() == 6);
+            REQUIRE(r.std_error.rows() == 6);
+            REQUIRE(r.std_error.isApprox(r.sigma.diagonal()));
+        }
+        REQUIRE(result.std_error.isApprox(inverted.std_error, 1e-8));
+
         Matrix img_inv = obj2img(obj, result.exterior, interior, result.rotate);
 
         for (int r = 0; r != 4; ++r)
@@ -43,4 +57,328 @@ TEST_CASE("space resection")
             }
         }
     }
-}
\ No newline at end of file
+
+    SECTION("fixed-size projection equals dynamic projection")
+    {
+        Matrix obj(2, 3);
+        obj << 36589.41, 25273.32, 2195.17,
+            37631.08, 31324.51, 728.69;
+        Interior interior{.x = 0, .y = 0, .f = 153.24 / 1000, .m = 50000};
+        Exterior exterior{39795.45, 27476.46, 7572.69, -0.0040, 0.0021, -0.0676};
+
+        Matrix img = obj2img(obj, exterior, interior);
+        Matrix3 rotate = ex2yxzRotation3(exterior);
+        REQUIRE(Matrix(rotate).isApprox(ex2yxzRotation(exterior)));
+        for (int r = 0; r != 2; ++r)
+        {
+            Vector2 p = obj2img3(obj.row(r).transpose(), exterior, interior, rotate);
+            REQUIRE_THAT(p.x() - img(r, 0), WithinAbs(0, 1e-12));
+            REQUIRE_THAT(p.y() - img(r, 1), WithinAbs(0, 1e-12));
+
+            Vector3 isp = obj2isp3(obj.row(r).transpose(), exterior, rotate);
+            Vector3 aux = isp2aux3(isp, rotate);
+            REQUIRE(aux.isApprox(obj.row(r).transpose() - xyz2vec3(exterior.x, exterior.y, exterior.z)));
+        }
+
+        const size_t n = 20000;
+        std::vector<double> x(n), y(n), z(n), img_x(n), img_y(n);
+        for (size_t i = 0; i != n; ++i)
+        {
+            x[i] = 36000.0 + 0.2 * i;
+            y[i] = 25000.0 + 0.3 * (i % 1000);
+            z[i] = 500.0 + (i % 17);
+        }
+        obj2imgSoA(x, y, z, exterior, interior, rotate, img_x, img_y);
+        for (size_t i = 0; i < n; i += 97)
+        {
+            Vector2 p = obj2img3(Vector3(x[i], y[i], z[i]), exterior, interior, rotate);
+            REQUIRE_THAT(p.x() - img_x[i], WithinAbs(0, 1e-12));
+            REQUIRE_THAT(p.y() - img_y[i], WithinAbs(0, 1e-12));
+        }
+        REQUIRE_THROWS_AS(
+            obj2imgSoA(x, y, std::span(z).first(10), exterior, interior, rotate, img_x, img_y),
+            std::invalid_argument);
+    }
+
+    SECTION("batch")
+    {
+        Matrix all(4, 5);
+        all << -86.15, -68.99, 36589.41, 25273.32, 2195.17,
+            -53.40, 82.21, 37631.08, 31324.51, 728.69,
+            -14.78, -76.63, 39100.97, 24934.98, 2386.50,
+            10.46, 64.43, 40426.54, 30319.81, 757.31;
+        Interior interior{.x = 0, .y = 0, .f = 153.24 / 1000, .m = 50000};
+
+        std::vector<Space_Resection_Job> jobs;
+        for (int i = 0; i != 64; ++i)
+        {
+            Matrix obj = all.rightCols(3);
+            obj.col(0).array() += 100.0 * i;
+            obj.col(1).array() -= 50.0 * i;
+            jobs.push_back({interior, all.leftCols(2) / 1000, obj});
+        }
+
+        std::vector<Space_Resection_Result> results = batchSpaceResection(jobs);
+        REQUIRE(results.size() == jobs.size());
+        for (size_t i = 0; i != jobs.size(); ++i)
+        {
+            Space_Resection_Result single = spaceResection(jobs[i].interior, jobs[i].image, jobs[i].object);
+            REQUIRE(results[i].info == Iterative_Algo_Info::SUCCESS);
+            REQUIRE(results[i].iterations == single.iterations);
+            REQUIRE(results[i].iterations > 0);
+            REQUIRE(results[i].elapsed >= 0.0);
+            REQUIRE_THAT(results[i].exterior.x - single.exterior.x, WithinAbs(0, 1e-9));
+            REQUIRE_THAT(results[i].exterior.kappa - single.exterior.kappa, WithinAbs(0, 1e-12));
+        }
+
+        jobs[3].object = Matrix(3, 3);
+        REQUIRE_THROWS_AS(batchSpaceResection(jobs), std::invalid_argument);
+    }
+
+    SECTION("accumulated normal equation equals design matrix product")
+    {
+        Matrix rotate = ex2yxzRotation(Exterior{39795.45, 27476.46, 7572.69, -0.0040, 0.0021, -0.0676});
+        Matrix A(8, 6), L(8, 1);
+        Matrix6 normal = Matrix6::Zero();
+        Vector6 rhs = Vector6::Zero();
+        for (int i = 0; i != 4; ++i)
+        {
+            Collinearity_Condition_Equation_Coefficient c = cceSimplifyNone(
+                {.x = 0.01 * i - 0.02,
+                 .y = 0.03 - 0.015 * i,
+                 .f = 0.15324,
+                 .h = 7662.0,
+                 .kappa = -0.0676,
+                 .omega = 0.0021,
+                 .z = -0.15324 + 1e-4 * i,
+                 .rotate = rotate});
+            double lx = 1e-5 * (i + 1), ly = -2e-5 * i;
+            A.middleRows(2 * i, 2) = c.toMatrix26();
+            L(2 * i) = lx;
+            L(2 * i + 1) = ly;
+            c.accumulate26(normal, rhs, lx, ly);
+        }
+        REQUIRE(Matrix(normal).isApprox(A.transpose() * A, 1e-12));
+        REQUIRE(Matrix(rhs).isApprox(A.transpose() * L, 1e-12));
+    }
+
+    SECTION("closed-form initial exterior")
+    {
+        const Interior interior{.x = 0, .y = 0, .f = 153.24 / 1000, .m = 50000};
+        const Exterior truth{39795.45, 27476.46, 7572.69, 0.35, -0.25, 1.2};
+        const Matrix3 rotate = ex2yxzRotation3(truth);
+
+        Exterior round_trip = Exterior::makeFrom(Vector3(truth.x, truth.y, truth.z), rotate);
+        REQUIRE_THAT(round_trip.phi - truth.phi, WithinAbs(0, 1e-12));
+        REQUIRE_THAT(round_trip.omega - truth.omega, WithinAbs(0, 1e-12));
+        REQUIRE_THAT(round_trip.kappa - truth.kappa, WithinAbs(0, 1e-12));
+
+        Matrix obj(12, 3), img(12, 2);
+        for (int r = 0; r != 12; ++r)
+        {
+            // scatter points around the ground footprint of the oblique view
+            const Vector3 dir = rotate * Vector3(0.06 * ((r % 4) - 1.5), 0.06 * ((r / 4) - 1.0), -interior.f);
+            const double t = (300.0 * (r % 3) - truth.z) / dir.z();
+            obj.row(r) = (Vector3(truth.x, truth.y, truth.z) + t * dir).transpose();
+            img.row(r) = obj2img3(obj.row(r).transpose(), truth, interior, rotate).transpose();
+        }
+
+        for (const Exterior_Initializer &init : {Exterior_Initializer(p3pExterior), Exterior_Initializer(dltExterior)})
+        {
+            Exterior ex = init(interior, img, obj);
+            REQUIRE_THAT(ex.x - truth.x, WithinAbs(0, 1e-3));
+            REQUIRE_THAT(ex.y - truth.y, WithinAbs(0, 1e-3));
+            REQUIRE_THAT(ex.z - truth.z, WithinAbs(0, 1e-3));
+            REQUIRE_THAT(ex.phi - truth.phi, WithinAbs(0, 1e-6));
+            REQUIRE_THAT(ex.omega - truth.omega, WithinAbs(0, 1e-6));
+            REQUIRE_THAT(ex.kappa - truth.kappa, WithinAbs(0, 1e-6));
+        }
+
+        Space_Resection_Result result = spaceResection(interior, img, obj);
+        REQUIRE(result.info == Iterative_Algo_Info::SUCCESS);
+        REQUIRE(result.iterations <= 4);
+        REQUIRE_THAT(result.exterior.kappa - truth.kappa, WithinAbs(0, 1e-6));
+
+        // an oriented image is refined from its own exterior elements
+        Exterior near = truth;
+        near.x += 2.0;
+        near.kappa += 1e-3;
+        Space_Resection_Result
+            refined = spaceResection(Oriented_Image(Image_Meta_Data{near, interior}), img, obj),
+            started = spaceResection(
+                interior, img, obj, 50, 1e-5, cceSimplifyNone, {},
+                [&near](const Interior &, const Matrix &, const Matrix &)
+                { return near; });
+        REQUIRE(refined.info == Iterative_Algo_Info::SUCCESS);
+        REQUIRE(refined.iterations == started.iterations);
+        REQUIRE_THAT(refined.exterior.x - started.exterior.x, WithinAbs(0, 1e-12));
+        REQUIRE_THAT(refined.exterior.kappa - truth.kappa, WithinAbs(0, 1e-6));
+
+        // coplanar points fall back to p3p
+        obj.col(2).setConstant(0.0);
+        for (int r = 0; r != 12; ++r)
+        {
+            img.row(r) = obj2img3(obj.row(r).transpose(), truth, interior, rotate).transpose();
+        }
+        Exterior ex = dltExterior(interior, img, obj);
+        REQUIRE_THAT(ex.phi - truth.phi, WithinAbs(0, 1e-6));
+        REQUIRE_THROWS_AS(dltExterior(interior, img.topRows(5), obj.topRows(5)), std::invalid_argument);
+    }
+
+    SECTION("levenberg marquardt")
+    {
+        Matrix all(4, 5);
+        all << -86.15, -68.99, 36589.41, 25273.32, 2195.17,
+            -53.40, 82.21, 37631.08, 31324.51, 728.69,
+            -14.78, -76.63, 39100.97, 24934.98, 2386.50,
+            10.46, 64.43, 40426.54, 30319.81, 757.31;
+        Matrix img = all.leftCols(2) / 1000, obj = all.rightCols(3);
+        Interior interior{.x = 0, .y = 0, .f = 153.24 / 1000, .m = 50000};
+
+        Space_Resection_Result
+            gn = spaceResection(interior, img, obj, 50, 1e-5, cceSimplifyNone, {}, centroidExterior),
+            lm = spaceResection(
+                interior, img, obj, 50, 1e-5, cceSimplifyNone, {}, centroidExterior,
+                {.method = Iterative_Step_Method::LEVENBERG_MARQUARDT});
+
+        REQUIRE(gn.info == Iterative_Algo_Info::SUCCESS);
+        REQUIRE(lm.info == Iterative_Algo_Info::SUCCESS);
+        REQUIRE_THAT(gn.exterior.x - lm.exterior.x, WithinAbs(0, 1e-2));
+        REQUIRE_THAT(gn.exterior.kappa - lm.exterior.kappa, WithinAbs(0, 1e-5));
+
+        for (const Space_Resection_Result &r : {gn, lm})
+        {
+            REQUIRE(r.telemetry.rmse.size() == r.iterations);
+            REQUIRE(r.telemetry.correction_norm.size() == r.iterations);
+            REQUIRE(r.telemetry.lambda.size() == r.iterations);
+            REQUIRE(r.telemetry.rmse.back() < r.telemetry.rmse.front());
+        }
+        REQUIRE(gn.telemetry.lambda.front() == 0.0);
+        REQUIRE(lm.telemetry.lambda.front() > 0.0);
+        for (size_t i = 1; i < lm.telemetry.rmse.size(); ++i)
+        {
+            REQUIRE(lm.telemetry.rmse[i] <= lm.telemetry.rmse[i - 1]);
+        }
+
+        // residuals never decrease, every damped try is rejected
+        Matrix bad = img;
+        bad(0, 0) = std::numeric_limits<double>::quiet_NaN();
+        Space_Resection_Result stalled = spaceResection(
+            interior, bad, obj, 50, 1e-5, cceSimplifyNone, {}, centroidExterior,
+            {.method = Iterative_Step_Method::LEVENBERG_MARQUARDT, .max_reject = 3});
+        REQUIRE(stalled.info == Iterative_Algo_Info::NOT_CONVERGED);
+        REQUIRE(stalled.iterations == 1);
+    }
+
+    SECTION("incremental quaternion")
+    {
+        const Interior interior{.x = 0, .y = 0, .f = 153.24 / 1000, .m = 50000};
+        const Exterior truth{39795.45, 27476.46, 7572.69, 0.3, 1.45, -0.8};
+        const Matrix3 rotate = ex2yxzRotation3(truth);
+        REQUIRE(Matrix3(ex2quaternion(truth).toRotationMatrix()).isApprox(rotate, 1e-12));
+
+        // coefficients equal numeric derivatives of projection under R * exp([d]x)
+        const Vector3 obj(38000.0, 29000.0, 400.0);
+        const Vector3 isp = obj2isp3(obj, truth, rotate);
+        const Collinearity_Condition_Equation_Coefficient c = cceIncremental(isp, interior.f, rotate);
+        const double h = 1e-7;
+        for (int k = 0; k != 3; ++k)
+        {
+            Vector3 d = Vector3::Zero();
+            d(k) = h;
+            const Matrix3 turned = rotate * Eigen::AngleAxisd(h, d.normalized()).toRotationMatrix();
+            const Vector2 diff =
+                (obj2img3(obj, truth, interior, turned) - obj2img3(obj, truth, interior, rotate)) / h;
+            REQUIRE_THAT(diff.x() - c.row1()(3 + k), WithinAbs(0, 1e-6));
+            REQUIRE_THAT(diff.y() - c.row2()(3 + k), WithinAbs(0, 1e-6));
+        }
+
+        Matrix obj_pts(12, 3), img(12, 2);
+        for (int r = 0; r != 12; ++r)
+        {
+            const Vector3 dir = rotate * Vector3(0.06 * ((r % 4) - 1.5), 0.06 * ((r / 4) - 1.0), -interior.f);
+            const double t = (300.0 * (r % 3) - truth.z) / dir.z();
+            obj_pts.row(r) = (Vector3(truth.x, truth.y, truth.z) + t * dir).transpose();
+            img.row(r) = obj2img3(obj_pts.row(r).transpose(), truth, interior, rotate).transpose();
+        }
+
+        // near gimbal lock of (y, x, z) angles, start away from the solution
+        auto rough = [&](const Interior &, const Matrix &, const Matrix &)
+        {
+            Exterior ex = truth;
+            ex.x += 200.0;
+            ex.z -= 300.0;
+            ex.phi += 0.05;
+            ex.omega += 0.08;
+            ex.kappa -= 0.05;
+            return ex;
+        };
+        Space_Resection_Result result = spaceResection(
+            interior, img, obj_pts, 50, 1e-8, cceSimplifyNone, {}, rough, {},
+            Rotation_Parameterization::INCREMENTAL_QUATERNION);
+        REQUIRE(result.info == Iterative_Algo_Info::SUCCESS);
+        REQUIRE(result.iterations <= 8);
+        REQUIRE(Matrix3(result.rotate).isApprox(rotate, 1e-8));
+        REQUIRE_THAT(result.exterior.x - truth.x, WithinAbs(0, 1e-3));
+        REQUIRE_THAT(result.exterior.z - truth.z, WithinAbs(0, 1e-3));
+
+        // same solution as angle parameterization on ordinary image
+        Matrix all(4, 5);
+        all << -86.15, -68.99, 36589.41, 25273.32, 2195.17,
+            -53.40, 82.21, 37631.08, 31324.51, 728.69,
+            -14.78, -76.63, 39100.97, 24934.98, 2386.50,
+            10.46, 64.43, 40426.54, 30319.81, 757.31;
+        Space_Resection_Result
+            euler = spaceResection(interior, all.leftCols(2) / 1000, all.rightCols(3)),
+            quaternion = spaceResection(
+                interior, all.leftCols(2) / 1000, all.rightCols(3), 50, 1e-5, cceSimplifyNone, {}, p3pExterior,
+                {.method = Iterative_Step_Method::LEVENBERG_MARQUARDT},
+                Rotation_Parameterization::INCREMENTAL_QUATERNION);
+        REQUIRE(quaternion.info == Iterative_Algo_Info::SUCCESS);
+        REQUIRE_THAT(quaternion.exterior.x - euler.exterior.x, WithinAbs(0, 1e-2));
+        REQUIRE_THAT(quaternion.exterior.phi - euler.exterior.phi, WithinAbs(0, 1e-5));
+        REQUIRE_THAT(quaternion.exterior.kappa - euler.exterior.kappa, WithinAbs(0, 1e-5));
+    }
+
+    SECTION("ransac")
+    {
+        const Interior interior{.x = 0, .y = 0, .f = 153.24 / 1000, .m = 50000};
+        const Exterior truth{39795.45, 27476.46, 7572.69, -0.0040, 0.0021, -0.0676};
+        const Matrix3 rotate = ex2yxzRotation3(truth);
+
+        const int n = 30;
+        Matrix obj(n, 3), img(n, 2);
+        for (int r = 0; r != n; ++r)
+        {
+            obj.row(r) << truth.x - 4500.0 + 1500.0 * (r % 6), truth.y - 3000.0 + 1500.0 * (r / 6), 500.0 + 37.0 * r;
+            img.row(r) = obj2img3(obj.row(r).transpose(), truth, interior, rotate).transpose();
+        }
+
+        // mismatch a third of the control points
+        std::vector<char> truth_inliers(n, 1);
+        for (int r = 1; r < n; r += 3)
+        {
+            img.row(r) += Vector2(0.004 * ((r % 2) ? 1 : -1), 0.003).transpose();
+            truth_inliers[r] = 0;
+        }
+
+        Space_Resection_Result plain = spaceResection(interior, img, obj);
+        REQUIRE(!(plain.info == Iterative_Algo_Info::SUCCESS && plain.rmse < 1e-5));
+
+        Robust_Space_Resection_Result result = robustSpaceResection(interior, img, obj);
+        REQUIRE(result.resection.info == Iterative_Algo_Info::SUCCESS);
+        REQUIRE(result.inliers == truth_inliers);
+        REQUIRE(result.inlier_count == 20);
+        REQUIRE(result.trials <= Ransac_Option{}.max_trials);
+        REQUIRE(result.resection.image.rows() == 20);
+        REQUIRE_THAT(result.resection.exterior.x - truth.x, WithinAbs(0, 1e-3));
+        REQUIRE_THAT(result.resection.exterior.z - truth.z, WithinAbs(0, 1e-3));
+        REQUIRE_THAT(result.resection.exterior.kappa - truth.kappa, WithinAbs(0, 1e-7));
+
+        Robust_Space_Resection_Result again = robustSpaceResection(interior, img, obj);
+        REQUIRE(again.trials == result.trials);
+        REQUIRE(again.resection.exterior.x == result.resection.exterior.x);
+
+        REQUIRE_THROWS_AS(robustSpaceResection(interior, img, obj, {.confidence = 1.0}), std::invalid_argument);
+    }
+}
@@ -0,0 +1,112 @@
+#include <print>
+#include <format>
+#include <random>
+
+#include <lga/OfficialWork>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+using namespace Catch::Matchers;
+using namespace lga;
+
+using N = Elev_Net;
+using NT = Net_Traits<N>;
+
+TEST_CASE("sparse elev net adjust")
+{
+    SECTION("cofactor diagonal equals diagonal of dense inverse")
+    {
+        const int side = 12, size = side * side;
+        std::vector<Sparse_Triplet> triplets;
+        for (int r = 0; r != side; ++r)
+        {
+            for (int c = 0; c != side; ++c)
+            {
+                int i = r * side + c;
+                triplets.emplace_back(i, i, 4.5 + 0.01 * i);
+                if (c + 1 != side)
+                {
+                    triplets.emplace_back(i, i + 1, -1.0);
+                    triplets.emplace_back(i + 1, i, -1.0);
+                }
+                if (r + 1 != side)
+                {
+                    triplets.emplace_back(i, i + side, -1.0);
+                    triplets.emplace_back(i + side, i, -1.0);
+                }
+            }
+        }
+        Sparse_Matrix n(size, size);
+        n.setFromTriplets(triplets.begin(), triplets.end());
+
+        Sparse_Cholesky ldlt(n);
+        REQUIRE(ldlt.info() == Eigen::Success);
+
+        lga::Vector diag = cofactorDiagonal(ldlt);
+        Matrix inv = choleskyInverse(Matrix(n));
+        for (int i = 0; i != size; ++i)
+        {
+            REQUIRE_THAT(diag(i) - inv(i, i), WithinAbs(0, 1e-12));
+        }
+    }
+
+    SECTION("grid net")
+    {
+        const int side = 100;
+        constexpr double h0 = 100.0;
+        auto height = [](int r, int c)
+        { return h0 + 0.1 * r + 0.05 * c; };
+
+        N net;
+        std::vector<NT::Vertex_Descriptor> vds;
+        for (int r = 0; r != side; ++r)
+        {
+            for (int c = 0; c != side; ++c)
+            {
+                bool is_control = (r == 0 && c == 0) || (r == side - 1 && c == side - 1);
+                vds.push_back(boost::add_vertex(
+                    NT::Vertex_Property{std::format("{}-{}", r, c), is_control ? height(r, c) : 0.0, is_control},
+                    net));
+            }
+        }
+
+        std::mt19937 gen(42);
+        std::normal_distribution<double> noise(0.0, 1e-3);
+        int ei = 0;
+        for (int r = 0; r != side; ++r)
+        {
+            for (int c = 0; c != side; ++c)
+            {
+                if (c + 1 != side)
+                {
+                    boost::add_edge(
+                        vds[r * side + c], vds[r * side + c + 1],
+                        NT::Edge_Property{std::to_string(ei++), height(r, c + 1) - height(r, c) + noise(gen), 1.0},
+                        net);
+                }
+                if (r + 1 != side)
+                {
+                    boost::add_edge(
+                        vds[r * side + c], vds[(r + 1) * side + c],
+                        NT::Edge_Property{std::to_string(ei++), height(r + 1, c) - height(r, c) + noise(gen), 1.0},
+                        net);
+                }
+            }
+        }
+
+        Adjust_Net_Result<N> result = netAdjust(net);
+        REQUIRE(result.sigma.size() == 0);
+        REQUIRE(result.std_error.rows() == side * side - 2);
+        REQUIRE((result.std_error.array() > 0.0).all());
+
+        auto vert_prop = boost::get(NT::Vertex_Property_Tag, net);
+        for (int r = 0; r != side; ++r)
+        {
+            for (int c = 0; c != side; ++c)
+            {
+                REQUIRE_THAT(boost::get(vert_prop, vds[r * side + c]).elev - height(r, c), WithinAbs(0, 1e-2));
+            }
+        }
+    }
+}
@@ -0,0 +1,99 @@
+#include <print>
+#include <random>
+#include <vector>
+
+#include <lga/Photogrammetry>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+using namespace Catch::Matchers;
+using namespace lga;
+
+TEST_CASE("track triangulation")
+{
+    const Interior interior{.x = 0, .y = 0, .f = 153.24 / 1000, .m = 50000};
+    std::vector<Oriented_Image> images;
+    for (const Exterior &ex : std::vector<Exterior>{
+             {0.0, 0.0, 7662.0, 0.002, -0.001, 0.01},
+             {4000.0, 50.0, 7680.0, -0.001, 0.002, 0.005},
+             {8000.0, -30.0, 7650.0, 0.0, 0.001, -0.004},
+             {4000.0, 5000.0, 7670.0, 0.05, -0.03, 1.2}})
+    {
+        images.emplace_back(Image_Meta_Data{ex, interior});
+    }
+
+    // each track is seen on 2 to 4 images, starting at a varying image
+    const int n = 3000;
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<double> noise(-2e-6, 2e-6);
+    Matrix truth(n, 3);
+    std::vector<Track_Observation> observations;
+    std::vector<size_t> offsets{0};
+    for (int t = 0; t != n; ++t)
+    {
+        truth.row(t) << 3000.0 + 2.0 * (t % 50) * 20.0, 1000.0 + (t / 60) * 50.0, 100.0 + 3.0 * (t % 7);
+        const size_t seen = 2 + t % 3;
+        for (size_t k = 0; k != seen; ++k)
+        {
+            const size_t i = (t + k) % images.size();
+            const Vector2 img = images[i].obj2img(truth.row(t).transpose());
+            observations.push_back({.image = i, .x = img.x(), .y = img.y()});
+        }
+        offsets.push_back(observations.size());
+    }
+
+    SECTION("exact observations")
+    {
+        Space_Intersection_Batch_Result result = triangulateTracks(images, observations, offsets);
+        REQUIRE(result.info == Iterative_Algo_Info::SUCCESS);
+        REQUIRE(result.coordinate.rows() == n);
+        for (int t = 0; t != n; ++t)
+        {
+            REQUIRE((result.coordinate.row(t) - truth.row(t)).norm() < 1e-4);
+        }
+
+        // tracks on all four images match batch intersection of the same points
+        std::vector<Space_Intersection_Ols_Block> blocks;
+        for (const Oriented_Image &image : images)
+        {
+            blocks.push_back({.meta = image.meta(), .image = obj2img(truth, image)});
+        }
+        std::vector<Track_Observation> full;
+        std::vector<size_t> full_offsets{0};
+        for (int t = 0; t != n; ++t)
+        {
+            for (size_t i = 0; i != images.size(); ++i)
+            {
+                full.push_back({.image = i, .x = blocks[i].image(t, 0), .y = blocks[i].image(t, 1)});
+            }
+            full_offsets.push_back(full.size());
+        }
+        Space_Intersection_Batch_Result tracks = triangulateTracks(images, full, full_offsets);
+        Space_Intersection_Batch_Result batch = batchSpaceIntersection(blocks);
+        REQUIRE(tracks.coordinate.isApprox(batch.coordinate, 1e-9));
+    }
+
+    SECTION("noisy observations")
+    {
+        for (Track_Observation &obs : observations)
+        {
+            obs.x += noise(gen);
+            obs.y += noise(gen);
+        }
+        Space_Intersection_Batch_Result result = triangulateTracks(images, observations, offsets);
+        REQUIRE(result.info == Iterative_Algo_Info::SUCCESS);
+        for (int t = 0; t != n; ++t)
+        {
+            REQUIRE((result.coordinate.row(t) - truth.row(t)).norm() < 5.0);
+            REQUIRE(result.rmse(t) < 1e-5);
+        }
+
+        std::vector<size_t> short_track{0, 2, 3};
+        REQUIRE_THROWS_AS(triangulateTracks(images, std::span(observations).first(3), short_track), std::invalid_argument);
+        std::vector<size_t> open_end{0, 2};
+        REQUIRE_THROWS_AS(triangulateTracks(images, std::span(observations).first(3), open_end), std::invalid_argument);
+        observations[0].image = images.size();
+        REQUIRE_THROWS_AS(triangulateTracks(images, observations, offsets), std::invalid_argument);
+    }
+}